@@ -0,0 +1,1115 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Benchmark program for the performance critical parts of jrnf_tools.
+ * Build with "make bench" and call with the parameter naming the benchmark
+ * (e.g. "./jrnf_bench coupling").
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <utility>
+#include <iterator>
+
+#include "net_tools/reaction_network.h"
+#include "net_tools/reaction_network_fileop.h"
+#include "net_tools/network_tools.h"
+#include "tools/cl_para.h"
+#include "reaction_macros.h"
+#include "coupling_assembly.h"
+#include "jrnf_stream.h"
+#include "jrnf_mmap.h"
+#include "network_io.h"
+#include "rng.h"
+#include "reaction_store.h"
+#include "network_transform.h"
+#include "sbml_writer.h"
+#include "number_format.h"
+#include "edge_generators.h"
+#include "thread_pool.h"
+#include "create_modes.h"
+#include "resource_usage.h"
+using namespace std;
+
+
+/*
+ * Generates a random edge list with M links between N nodes and C couples
+ * in the form the couple_* functions of net_tools give them (indices into
+ * the edge list after erasing the previously coupled links).
+ */
+
+void random_coupled_edges(vector< pair<size_t, size_t> >& edges,
+                          vector< pair<size_t, size_t> >& couples,
+                          size_t N, size_t M, size_t C) {
+    rn_rng rng(M, 1);
+    for(size_t i=0; i<M; ++i)
+        edges.push_back(make_pair(rng.below(N), rng.below(N)));
+
+    size_t left=M;
+    for(size_t i=0; i<C && left >= 2; ++i, left -= 2) {
+        size_t r1=rng.below(left-1);
+        size_t r2=r1+1+rng.below(left-r1-1);
+        couples.push_back(make_pair(r1, r2));
+    }
+}
+
+
+/*
+ * Assembly of coupled reactions by erasing from the edge list (version
+ * that was used in main.cpp before rm_assemble_coupled). Used as reference.
+ */
+
+void assemble_coupled_erase(vector<reaction>& re,
+                            vector< pair<size_t, size_t> > edges,
+                            const vector< pair<size_t, size_t> >& couples, rn_rng& rng) {
+    for(size_t i=0; i<couples.size(); ++i) {
+        size_t r1=couples[i].first;
+        size_t r2=couples[i].second;
+
+        size_t a(edges[r1].first), b(edges[r2].first),
+               c(edges[r1].second), d(edges[r2].second);
+
+        rm_2to2rev(re, a, b, c, d, 0, rng);
+
+        edges.erase(edges.begin()+r2);
+        edges.erase(edges.begin()+r1);
+    }
+
+    for(size_t t=0; t<edges.size(); ++t)
+        rm_1to1rev(re, edges[t].first, edges[t].second, 0);
+}
+
+
+/*
+ * Times the assembly of coupled networks for M=10^5..10^7 links with C
+ * close to M/2. The erase based reference is only run (and compared) up
+ * to `erase_max` links because of its O(C M) runtime.
+ */
+
+void bench_coupling(size_t erase_max) {
+    cout << "# coupling assembly" << endl;
+    cout << "# M C t_erase[s] t_assemble[s] identical" << endl;
+
+    for(size_t M=100000; M<=10000000; M *= 10) {
+        size_t N=M/10;
+        size_t C=M/2-M/20;
+        vector< pair<size_t, size_t> > edges, couples;
+        random_coupled_edges(edges, couples, N, M, C);
+
+        vector<reaction> re_new;
+        rn_rng rng(1);
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        rm_assemble_coupled(re_new, edges, couples, 0, rng);
+        double t_new=seconds_since(start);
+
+        if(M > erase_max) {
+            cout << M << " " << C << " - " << t_new << " -" << endl;
+            continue;
+        }
+
+        vector<reaction> re_old;
+        rng.seed(1);
+        start=chrono::steady_clock::now();
+        assemble_coupled_erase(re_old, edges, couples, rng);
+        double t_old=seconds_since(start);
+
+        vector<species> sp;
+        for(size_t t=0; t<N; ++t)
+            rm_add_species_ne(sp, t);
+
+        bool identical=(re_old.size() == re_new.size());
+        for(size_t i=0; identical && i<re_new.size(); ++i)
+            identical = (re_old[i].get_string(sp) == re_new[i].get_string(sp));
+
+        cout << M << " " << C << " " << t_old << " " << t_new << " " << (identical ? "yes" : "NO") << endl;
+    }
+}
+
+
+/*
+ * Network sink that only counts, for measuring pure parsing speed.
+ */
+
+class count_sink {
+public:
+    size_t sp_c, re_c;
+
+    count_sink() : sp_c(0), re_c(0) {}
+    void reserve(size_t, size_t) {}
+    void add_species(const string&, bool, double) {  ++sp_c;  }
+    void add_reaction(bool, double, double, double, double,
+                      const pair<size_t, size_t>*, size_t,
+                      const pair<size_t, size_t>*, size_t) {  ++re_c;  }
+};
+
+
+/*
+ * Writes an Erdos-Renyi like reaction network (as create_ER_NM does, but
+ * with random edges) with N=M/10 species and M reactions to `filename`.
+ */
+
+void write_random_network(const string& filename, size_t M) {
+    size_t N=M/10;
+    rn_rng rng(M);
+    jrnf_writer w;
+    w.open(filename);
+
+    for(size_t t=0; t<N; ++t)
+        rm_add_species(w, t, 0, rng);
+
+    for(size_t t=0; t<M; ++t)
+        rm_1to1rev(w, rng.below(N), rng.below(N));
+
+    w.close();
+}
+
+
+/*
+ * Compares read_jrnf_reaction_n with the memory mapped reader on files
+ * with M=10^5..`max_M` reactions. Throughput is given in MB/s of file.
+ */
+
+void bench_read(size_t max_M, const string& tmp) {
+    cout << "# jrnf reading" << endl;
+    cout << "# M size[MB] t_iostream[s] t_mmap[s] t_mmap_parse_only[s] MB/s_iostream MB/s_mmap" << endl;
+
+    for(size_t M=100000; M<=max_M; M *= 10) {
+        write_random_network(tmp, M);
+        mapped_file f;
+        f.open(tmp);
+        double mb=double(f.size())/1e6;
+        f.close();
+
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        {
+            vector<species> sp;
+            vector<reaction> re;
+            read_jrnf_reaction_n(tmp, sp, re);
+        }
+        double t_old=seconds_since(start);
+
+        start=chrono::steady_clock::now();
+        {
+            vector<species> sp;
+            vector<reaction> re;
+            read_jrnf_mmap(tmp, sp, re);
+        }
+        double t_new=seconds_since(start);
+
+        start=chrono::steady_clock::now();
+        count_sink cs;
+        read_jrnf_mmap(tmp, cs);
+        double t_parse=seconds_since(start);
+
+        cout << M << " " << mb << " " << t_old << " " << t_new << " " << t_parse << " ";
+        cout << mb/t_old << " " << mb/t_new << endl;
+    }
+
+    remove(tmp.c_str());
+}
+
+
+/*
+ * Fills `st` with n species "A_<offset>".."A_<offset+n-1>" and n random 
+ * "A <-> B" reactions.
+ */
+
+void random_store(rn_store& st, size_t offset, size_t n, rn_rng& rng) {
+    st.clear();
+    for(size_t t=0; t<n; ++t)
+        rm_add_species(st, offset+t, 0, rng);
+
+    for(size_t t=0; t<n; ++t)
+        rm_1to1rev(st, rng.below(n), rng.below(n));
+}
+
+
+/*
+ * Times combining two networks with n=10^4..10^6 species each (half of
+ * the species names are shared) with rn_combine, and with
+ * combine_r_networks of net_tools up to `ref_max` species.
+ */
+
+void bench_combine(size_t ref_max) {
+    cout << "# combining networks" << endl;
+    cout << "# n_species species_out t_combine_r_networks[s] t_rn_combine[s]" << endl;
+
+    rn_rng rng(3);
+    for(size_t n=10000; n<=1000000; n *= 10) {
+        rn_store a, b, out;
+        random_store(a, 0, n, rng);
+        random_store(b, n/2, n, rng);
+
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        rn_combine(a, b, out);
+        double t_new=seconds_since(start);
+
+        cout << n << " " << out.species_count() << " ";
+
+        if(n <= ref_max) {
+            vector<species> sp_a, sp_b, sp;
+            vector<reaction> re_a, re_b, re;
+            a.to_vectors(sp_a, re_a);
+            b.to_vectors(sp_b, re_b);
+
+            start=chrono::steady_clock::now();
+            combine_r_networks(sp_a, re_a, sp_b, re_b, sp, re);
+            cout << seconds_since(start) << " ";
+        } else
+            cout << "- ";
+
+        cout << t_new << endl;
+    }
+}
+
+
+/*
+ * Compares the networks `sp_a` / `re_a` and `sp_b` / `re_b` (all species
+ * and reaction properties, educts and products in order). Returns an
+ * empty string if they are equal, otherwise the first difference.
+ */
+
+string network_difference(const vector<species>& sp_a, const vector<reaction>& re_a,
+                          const vector<species>& sp_b, const vector<reaction>& re_b) {
+    if(sp_a.size() != sp_b.size() || re_a.size() != re_b.size())
+        return "sizes " + to_string(sp_a.size()) + "/" + to_string(re_a.size()) + " vs "
+               + to_string(sp_b.size()) + "/" + to_string(re_b.size());
+
+    for(size_t i=0; i<sp_a.size(); ++i)
+        if(sp_a[i].get_name() != sp_b[i].get_name() || sp_a[i].is_constant() != sp_b[i].is_constant() ||
+           sp_a[i].get_energy() != sp_b[i].get_energy())
+            return "species " + to_string(i);
+
+    for(size_t i=0; i<re_a.size(); ++i)
+        if(re_a[i].is_reversible() != re_b[i].is_reversible() || re_a[i].get_c() != re_b[i].get_c() ||
+           re_a[i].get_k() != re_b[i].get_k() || re_a[i].get_k_b() != re_b[i].get_k_b() ||
+           re_a[i].get_activation() != re_b[i].get_activation() ||
+           re_a[i].get_educts() != re_b[i].get_educts() || re_a[i].get_products() != re_b[i].get_products())
+            return "reaction " + to_string(i);
+
+    return "";
+}
+
+
+/*
+ * Checks that rn_filter_r / rn_filter_s / rn_combine give the same
+ * networks as filter_r_network_r / filter_r_network_s / combine_r_networks
+ * of net_tools. The jrnf-files `files` are read with read_jrnf_reaction_n
+ * (if none are given coupled networks are generated); every file is
+ * filtered by its first, middle and last and a random species and
+ * combined with the next file (the last with the first). Prints one line
+ * per check, returns the number of differences.
+ */
+
+size_t bench_transform_parity(const vector<string>& files) {
+    cout << "# transform parity with net_tools (check file species result)" << endl;
+
+    vector< vector<species> > sps;
+    vector< vector<reaction> > res;
+    vector<string> names=files;
+
+    for(size_t i=0; i<files.size(); ++i) {
+        sps.push_back(vector<species>());
+        res.push_back(vector<reaction>());
+        if(read_jrnf_reaction_n(files[i], sps.back(), res.back())) {
+            cout << "Error at reading " << files[i] << "!" << endl;
+            return 1;
+        }
+    }
+
+    if(files.empty())
+        for(size_t i=0; i<2; ++i) {
+            create_para p;
+            p.mode="create_ER_NM_bi_C";
+            p.N=1000;
+            p.M=3000;
+            p.C=500;
+            p.fast=true;
+
+            rn_store st;
+            create_network(p, 11+i, st, false);
+            sps.push_back(vector<species>());
+            res.push_back(vector<reaction>());
+            st.to_vectors(sps.back(), res.back());
+            names.push_back(p.mode+"_"+to_string(11+i));
+        }
+
+    size_t diffs=0;
+    rn_rng rng(5);
+    for(size_t f=0; f<sps.size(); ++f) {
+        rn_store st, st_out;
+        rn_store_from_vectors(st, sps[f], res[f]);
+        species_index idx(st);
+
+        size_t n=sps[f].size();
+        vector<size_t> picks={0, n/2, n-1, rng.below(n)};
+        for(size_t j=0; j<picks.size() && n != 0; ++j) {
+            string name=sps[f][picks[j]].get_name();
+            vector<bool> removed;
+            rn_mark_species(st, idx, name, removed);
+
+            for(size_t m=0; m<2; ++m) {
+                vector<species> sp_ref, sp_new;
+                vector<reaction> re_ref, re_new;
+
+                if(m == 0) {
+                    filter_r_network_r(sps[f], res[f], sp_ref, re_ref, name);
+                    rn_filter_r(st, st_out, removed);
+                } else {
+                    filter_r_network_s(sps[f], res[f], sp_ref, re_ref, name);
+                    rn_filter_s(st, st_out, removed);
+                }
+
+                st_out.to_vectors(sp_new, re_new);
+                string d=network_difference(sp_ref, re_ref, sp_new, re_new);
+                cout << (m == 0 ? "filter_r " : "filter_s ") << names[f] << " " << name << " "
+                     << (d.empty() ? "ok" : "DIFFERENT ("+d+")") << endl;
+                diffs += !d.empty();
+            }
+        }
+
+        size_t g=(f+1) % sps.size();
+        rn_store other, comb;
+        rn_store_from_vectors(other, sps[g], res[g]);
+        rn_combine(st, other, comb);
+
+        vector<species> sp_ref, sp_new;
+        vector<reaction> re_ref, re_new;
+        combine_r_networks(sps[f], res[f], sps[g], res[g], sp_ref, re_ref);
+        comb.to_vectors(sp_new, re_new);
+        string d=network_difference(sp_ref, re_ref, sp_new, re_new);
+        cout << "combine " << names[f] << " " << names[g] << " " << (d.empty() ? "ok" : "DIFFERENT ("+d+")") << endl;
+        diffs += !d.empty();
+    }
+
+    return diffs;
+}
+
+
+/*
+ * Writes `st` as jrnf with iostream operator<< (the way jrnf_writer and
+ * write_jrnf_reaction_n did before). Used as reference.
+ */
+
+void write_jrnf_iostream(const string& filename, const rn_store& st) {
+    ofstream out(filename.c_str());
+    out << "jrnf0003\n" << st.species_count() << " " << st.reaction_count() << "\n";
+
+    for(size_t i=0; i<st.species_count(); ++i)
+        out << (st.constant[i] != 0) << " " << st.species_name(i) << " " << st.energy[i] << "\n";
+
+    for(size_t i=0; i<st.reaction_count(); ++i) {
+        out << (st.reversible[i] != 0) << " " << st.c[i] << " " << st.k[i] << " " << st.k_b[i] << " " << st.activation[i];
+        out << " " << st.educt_count(i) << " " << st.product_count(i);
+        for(size_t j=0; j<st.educt_count(i); ++j)
+            out << " " << st.educts(i)[j].first << " " << st.educts(i)[j].second;
+        for(size_t j=0; j<st.product_count(i); ++j)
+            out << " " << st.products(i)[j].first << " " << st.products(i)[j].second;
+        out << "\n";
+    }
+}
+
+
+/*
+ * Returns the size of file `filename` in MB.
+ */
+
+double file_mb(const string& filename) {
+    ifstream in(filename.c_str(), ios::binary | ios::ate);
+    return double(in.tellg())/1e6;
+}
+
+
+/*
+ * Returns the content of the file `filename` (empty if it can't be read).
+ */
+
+string file_content(const string& filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+
+/*
+ * Checks byte for byte that write_sbml (one thread and all cores) and the
+ * streaming sbml_writer give the same file as write_sbml_reaction_n of
+ * net_tools and as each other, for the jrnf-files `files` or (if none are given) a coupled
+ * network with random energies and constants. Prints one line per writer
+ * and network, returns the number of differences.
+ */
+
+size_t bench_sbml_parity(const vector<string>& files, const string& tmp) {
+    cout << "# sbml parity with write_sbml_reaction_n (writer network result)" << endl;
+
+    vector<rn_store> nets(files.empty() ? 1 : files.size());
+    vector<string> names=files;
+    for(size_t i=0; i<files.size(); ++i)
+        if(read_network(files[i], nets[i])) {
+            cout << "Error at reading " << files[i] << "!" << endl;
+            return 1;
+        }
+
+    if(files.empty()) {
+        rn_rng rng(3);
+        for(size_t t=0; t<1000; ++t)
+            rm_add_species(nets[0], t, 0, rng);
+        for(size_t t=0; t<5000; ++t)
+            rm_2to2rev(nets[0], rng.below(1000), rng.below(1000), rng.below(1000), rng.below(1000), 0, rng);
+        names.push_back("random");
+    }
+
+    output_precision()=0;
+    size_t diffs=0;
+    for(size_t i=0; i<nets.size(); ++i) {
+        vector<species> sp;
+        vector<reaction> re;
+        nets[i].to_vectors(sp, re);
+        write_sbml_reaction_n(tmp, sp, re);
+        string ref=file_content(tmp), first;
+        bool same_writers=true;
+
+        for(size_t w=0; w<3; ++w) {
+            if(w == 2) {
+                sbml_writer sw;
+                sw.open(tmp);
+                nets[i].emit(sw);
+                sw.close();
+            } else
+                write_sbml(tmp, nets[i], w == 0 ? 1 : 0);
+
+            string out=file_content(tmp);
+            size_t at=mismatch(ref.begin(), ref.begin()+min(ref.size(), out.size()), out.begin()).first-ref.begin();
+            bool same=(out == ref);
+            const char* writer[]={"write_sbml_1", "write_sbml_all", "sbml_writer"};
+            cout << writer[w] << " " << names[i] << " "
+                 << (same ? string("identical") : "DIFFERENT (first at byte "+to_string(at)+")") << endl;
+            diffs += !same;
+
+            if(w == 0)
+                first.swap(out);
+            else
+                same_writers=same_writers && out == first;
+        }
+
+        cout << "jrnf_tools_writers " << names[i] << " " << (same_writers ? "identical" : "DIFFERENT") << endl;
+        diffs += !same_writers;
+    }
+
+    return diffs;
+}
+
+
+/*
+ * Times writing networks with M=10^5..`max_M` coupled reactions (random
+ * energies and constants, N=M/10 species) as jrnf with iostreams, with 
+ * jrnf_writer (shortest round trip and 6 digits) and as sbml (one thread
+ * and all cores). Throughput is given in MB/s of written file.
+ */
+
+void bench_write(size_t max_M, const string& tmp) {
+    cout << "# jrnf / sbml writing" << endl;
+    cout << "# M size[MB] t_iostream[s] t_to_chars[s] t_to_chars_p6[s] t_sbml_1[s] t_sbml_all[s]";
+    cout << " MB/s_iostream MB/s_to_chars MB/s_sbml_all" << endl;
+
+    for(size_t M=100000; M<=max_M; M *= 10) {
+        size_t N=M/10;
+        rn_rng rng(M);
+        rn_store st;
+        st.reserve(N, M);
+
+        for(size_t t=0; t<N; ++t)
+            rm_add_species(st, t, 0, rng);
+
+        for(size_t t=0; t<M; ++t)
+            rm_2to2rev(st, rng.below(N), rng.below(N), rng.below(N), rng.below(N), 0, rng);
+
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        write_jrnf_iostream(tmp, st);
+        double t_old=seconds_since(start);
+        double mb_old=file_mb(tmp);
+
+        output_precision()=0;
+        start=chrono::steady_clock::now();
+        write_network(tmp, st);
+        double t_new=seconds_since(start);
+        double mb=file_mb(tmp);
+
+        output_precision()=6;
+        start=chrono::steady_clock::now();
+        write_network(tmp, st);
+        double t_p6=seconds_since(start);
+
+        output_precision()=0;
+        start=chrono::steady_clock::now();
+        write_sbml(tmp, st, 1);
+        double t_sbml_1=seconds_since(start);
+
+        start=chrono::steady_clock::now();
+        write_sbml(tmp, st, 0);
+        double t_sbml=seconds_since(start);
+        double mb_sbml=file_mb(tmp);
+
+        cout << M << " " << mb << " " << t_old << " " << t_new << " " << t_p6 << " " << t_sbml_1 << " " << t_sbml << " ";
+        cout << mb_old/t_old << " " << mb/t_new << " " << mb_sbml/t_sbml << endl;
+    }
+
+    remove(tmp.c_str());
+}
+
+
+/*
+ * Normalized histogram of the node degrees (in + out) of `edges`.
+ */
+
+vector<double> degree_distribution(const edge_list& edges, size_t N) {
+    vector<size_t> deg(N, 0);
+    for(size_t i=0; i<edges.size(); ++i) {
+        ++deg[edges[i].first];
+        ++deg[edges[i].second];
+    }
+
+    vector<double> dist;
+    for(size_t i=0; i<N; ++i) {
+        if(deg[i] >= dist.size())
+            dist.resize(deg[i]+1, 0.0);
+        dist[deg[i]] += 1.0/N;
+    }
+
+    return dist;
+}
+
+
+/*
+ * Total variation distance of two distributions.
+ */
+
+double tv_distance(vector<double> a, vector<double> b) {
+    a.resize(max(a.size(), b.size()), 0.0);
+    b.resize(a.size(), 0.0);
+
+    double d=0;
+    for(size_t i=0; i<a.size(); ++i)
+        d += fabs(a[i]-b[i]);
+    return d/2;
+}
+
+
+/*
+ * Compares the degree distribution of gen_erdos_renyi with the one of
+ * create_erdos_renyi (net_tools) for a sparse and a dense network (sum
+ * over 10 seeds) and times gen_erdos_renyi for M=10^6..`max_M` links 
+ * (N=M/10, no multiple links) on one and `threads` threads.
+ */
+
+void bench_er(size_t max_M, size_t threads) {
+    cout << "# Erdos-Renyi generator" << endl;
+    cout << "# N M tv_distance(net_tools, fast) (degree distribution, 10 networks)" << endl;
+
+    size_t sizes[2][2]={{10000, 50000}, {300, 40000}};
+    for(size_t j=0; j<2; ++j) {
+        size_t N=sizes[j][0], M=sizes[j][1];
+        edge_list e_ref, e_fast, e;
+
+        for(size_t seed=1; seed<=10; ++seed) {
+            e.clear();
+            srand(seed);
+            create_erdos_renyi(e, N, M, false, false, false);
+            e_ref.insert(e_ref.end(), e.begin(), e.end());
+
+            gen_erdos_renyi(e, N, M, false, false, false, seed, 1);
+            e_fast.insert(e_fast.end(), e.begin(), e.end());
+        }
+
+        cout << N << " " << M << " " << tv_distance(degree_distribution(e_ref, N), degree_distribution(e_fast, N)) << endl;
+    }
+
+    threads=thread_count(threads);
+    cout << "# N M t_1_thread[s] t_" << threads << "_threads[s] Medges/s" << endl;
+
+    for(size_t M=1000000; M<=max_M; M *= 10) {
+        edge_list e;
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        gen_erdos_renyi(e, M/10, M, false, false, false, 1, 1);
+        double t_1=seconds_since(start);
+
+        start=chrono::steady_clock::now();
+        gen_erdos_renyi(e, M/10, M, false, false, false, 1, threads);
+        double t_n=seconds_since(start);
+
+        cout << M/10 << " " << M << " " << t_1 << " " << t_n << " " << M/t_n/1e6 << endl;
+    }
+}
+
+
+/*
+ * Returns the number of distinct links in `e` (for undirected networks
+ * a-b and b-a are the same link).
+ */
+
+size_t distinct_links(edge_list e, bool directed) {
+    for(size_t i=0; i<e.size() && !directed; ++i)
+        if(e[i].first > e[i].second)
+            swap(e[i].first, e[i].second);
+
+    sort(e.begin(), e.end());
+    return unique(e.begin(), e.end())-e.begin();
+}
+
+
+/*
+ * Times create_barabasi_albert (net_tools, up to `ref_max` nodes) and
+ * gen_barabasi_albert (sequential and in batches of 1024 nodes on
+ * `threads` threads) for N=10^6..`max_N` nodes with M=2N links. The 
+ * degree distributions are compared for N=10^4 (10 networks). Checks
+ * that all M links are generated (also if M is close to and above the
+ * number of possible links), returns the number of failed checks.
+ */
+
+size_t bench_ba(size_t max_N, size_t ref_max, size_t threads) {
+    cout << "# Barabasi-Albert generator" << endl;
+    cout << "# N M self_loop links distinct_links expected" << endl;
+
+    size_t failed=0;
+    size_t ns[4]={10, 10, 10, 1000}, ms[4]={40, 45, 60, 400000};
+    for(size_t j=0; j<4; ++j)
+        for(size_t sl=0; sl<2; ++sl) {
+            edge_list e;
+            gen_barabasi_albert(e, ns[j], ms[j], false, sl, false, 1, threads, 16);
+            size_t expected=min(ms[j], ns[j]*(ns[j]-1)/2+(sl ? ns[j] : 0));
+            size_t d=distinct_links(e, false);
+            bool ok=(e.size() == expected && d == expected);
+            cout << ns[j] << " " << ms[j] << " " << sl << " " << e.size() << " " << d << " "
+                 << expected << (ok ? "" : " FAILED") << endl;
+            failed += !ok;
+        }
+
+    cout << "# N M tv_distance(net_tools, fast) tv_distance(fast, fast_batch) (degree distribution, 10 networks)" << endl;
+
+    {
+        size_t N=10000, M=2*N;
+        edge_list e_ref, e_fast, e_batch, e;
+
+        for(size_t seed=1; seed<=10; ++seed) {
+            e.clear();
+            srand(seed);
+            create_barabasi_albert(e, N, M, false, false, false);
+            e_ref.insert(e_ref.end(), e.begin(), e.end());
+
+            gen_barabasi_albert(e, N, M, false, false, false, seed, 1);
+            e_fast.insert(e_fast.end(), e.begin(), e.end());
+
+            gen_barabasi_albert(e, N, M, false, false, false, seed, threads, 1024);
+            e_batch.insert(e_batch.end(), e.begin(), e.end());
+        }
+
+        vector<double> d_fast=degree_distribution(e_fast, N);
+        cout << N << " " << M << " " << tv_distance(degree_distribution(e_ref, N), d_fast) << " ";
+        cout << tv_distance(d_fast, degree_distribution(e_batch, N)) << endl;
+
+        if(e_fast.size() != 10*M || e_batch.size() != 10*M) {
+            cout << "FAILED: " << e_fast.size() << " / " << e_batch.size() << " links instead of " << 10*M << endl;
+            ++failed;
+        }
+    }
+
+    threads=thread_count(threads);
+    cout << "# N M t_net_tools[s] t_fast[s] t_fast_batch_" << threads << "_threads[s]" << endl;
+
+    for(size_t N=1000000; N<=max_N; N *= 10) {
+        edge_list e;
+        cout << N << " " << 2*N << " ";
+
+        if(N <= ref_max) {
+            srand(1);
+            chrono::steady_clock::time_point start=chrono::steady_clock::now();
+            create_barabasi_albert(e, N, 2*N, false, false, false);
+            cout << seconds_since(start) << " ";
+            e.clear();
+        } else
+            cout << "- ";
+
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        gen_barabasi_albert(e, N, 2*N, false, false, false, 1, 1);
+        cout << seconds_since(start) << " ";
+
+        start=chrono::steady_clock::now();
+        gen_barabasi_albert(e, N, 2*N, false, false, false, 1, threads, 1024);
+        cout << seconds_since(start) << endl;
+    }
+
+    return failed;
+}
+
+
+/*
+ * Times create_watts_strogatz (net_tools, up to `ref_max` nodes) and
+ * gen_watts_strogatz on one and `threads` threads for N=10^5..`max_N` 
+ * nodes, M=2N links and alpha=0.1, 0.5, 1.0, and checks that the result
+ * doesn't depend on the number of threads. The degree distributions of
+ * both generators are compared for N=10^4 (10 networks per alpha).
+ */
+
+void bench_ws(size_t max_N, size_t ref_max, size_t threads) {
+    threads=thread_count(threads);
+    double alphas[3]={0.1, 0.5, 1.0};
+    cout << "# Watts-Strogatz generator" << endl;
+    cout << "# N M alpha tv_distance(net_tools, fast) (degree distribution, 10 networks)" << endl;
+
+    for(size_t j=0; j<3; ++j) {
+        size_t N=10000, M=2*N;
+        edge_list e_ref, e_fast, e;
+
+        for(size_t seed=1; seed<=10; ++seed) {
+            e.clear();
+            srand(seed);
+            create_watts_strogatz(e, N, M, alphas[j], false, false, false);
+            e_ref.insert(e_ref.end(), e.begin(), e.end());
+
+            gen_watts_strogatz(e, N, M, alphas[j], false, false, false, seed, threads);
+            e_fast.insert(e_fast.end(), e.begin(), e.end());
+        }
+
+        cout << N << " " << M << " " << alphas[j] << " "
+             << tv_distance(degree_distribution(e_ref, N), degree_distribution(e_fast, N)) << endl;
+    }
+
+    cout << "# N M alpha t_net_tools[s] t_fast_1_thread[s] t_fast_" << threads << "_threads[s] identical" << endl;
+
+    for(size_t N=100000; N<=max_N; N *= 10)
+        for(size_t j=0; j<3; ++j) {
+            edge_list e, e_n;
+            cout << N << " " << 2*N << " " << alphas[j] << " ";
+
+            if(N <= ref_max) {
+                srand(1);
+                chrono::steady_clock::time_point start=chrono::steady_clock::now();
+                create_watts_strogatz(e, N, 2*N, alphas[j], false, false, false);
+                cout << seconds_since(start) << " ";
+                e.clear();
+            } else
+                cout << "- ";
+
+            chrono::steady_clock::time_point start=chrono::steady_clock::now();
+            gen_watts_strogatz(e, N, 2*N, alphas[j], false, false, false, 1, 1);
+            cout << seconds_since(start) << " ";
+
+            start=chrono::steady_clock::now();
+            gen_watts_strogatz(e_n, N, 2*N, alphas[j], false, false, false, 1, threads);
+            cout << seconds_since(start) << " " << (e == e_n ? "yes" : "NO") << endl;
+        }
+}
+
+
+/*
+ * Times create_pan_sinha (net_tools, up to `ref_max` nodes) and gen_modular
+ * on one and `threads` threads for hierarchical modular networks with 
+ * N=10^5..`max_N` nodes, M=4N links, modules of 16 nodes, r=0.5 and h=10.
+ */
+
+void bench_modular(size_t max_N, size_t ref_max, size_t threads) {
+    threads=thread_count(threads);
+    cout << "# hierarchical modular generator (m=16, h=10, r=0.5)" << endl;
+    cout << "# N M t_net_tools[s] t_fast_1_thread[s] t_fast_" << threads << "_threads[s] identical" << endl;
+
+    for(size_t N=100000; N<=max_N; N *= 10) {
+        edge_list e, e_n;
+        cout << N << " " << 4*N << " ";
+
+        if(N <= ref_max) {
+            srand(1);
+            chrono::steady_clock::time_point start=chrono::steady_clock::now();
+            create_pan_sinha(e, N, 4*N, 10, 16, 0.5, false, false, false);
+            cout << seconds_since(start) << " ";
+            e.clear();
+        } else
+            cout << "- ";
+
+        chrono::steady_clock::time_point start=chrono::steady_clock::now();
+        gen_modular(e, N, 4*N, 16, 10, 0.5, true, false, false, false, 1, 1);
+        cout << seconds_since(start) << " ";
+
+        start=chrono::steady_clock::now();
+        gen_modular(e_n, N, 4*N, 16, 10, 0.5, true, false, false, false, 1, threads);
+        cout << seconds_since(start) << " " << (e == e_n ? "yes" : "NO") << endl;
+    }
+}
+
+
+/*
+ * One measurement of the benchmark suite: benchmark, implementation 
+ * (net_tools or jrnf_tools), network and the processed items (links, 
+ * reactions) and file size. Printed as one line of JSON.
+ */
+
+struct bench_record {
+    string bench, impl, mode;
+    size_t N, M, C, items, peak_kb;
+    double seconds, mb;
+
+    bench_record(const string& b, const string& i, const string& m, size_t n, size_t l, size_t c)
+        : bench(b), impl(i), mode(m), N(n), M(l), C(c), items(l), peak_kb(0), seconds(0), mb(0) {}
+
+    void print(ostream& o) const {
+        o << "{\"bench\": \"" << bench << "\", \"impl\": \"" << impl << "\", \"mode\": \"" << mode << "\"";
+        o << ", \"N\": " << N << ", \"M\": " << M << ", \"C\": " << C;
+        o << ", \"seconds\": " << seconds << ", \"items_per_s\": " << (seconds > 0 ? items/seconds : 0.0);
+        if(mb > 0)
+            o << ", \"mb\": " << mb << ", \"mb_per_s\": " << (seconds > 0 ? mb/seconds : 0.0);
+        o << ", \"peak_rss_mb\": " << peak_kb/1024.0 << "}" << endl;
+    }
+};
+
+
+/*
+ * Times `f()` and measures the peak memory, prints the record `r` (with
+ * the size of the file `file` that was read or written, if given).
+ */
+
+template<typename f_t>
+void measure(bench_record r, f_t f, const string& file="") {
+    reset_peak_memory();
+    chrono::steady_clock::time_point start=chrono::steady_clock::now();
+    f();
+    r.seconds=seconds_since(start);
+    r.peak_kb=peak_memory_kb();
+    if(!file.empty())
+        r.mb=file_mb(file);
+    r.print(cout);
+}
+
+
+/*
+ * Benchmark suite with machine readable output (one JSON object per line)
+ * for comparing versions of jrnf_tools and net_tools. For every size M
+ * in `sizes` (N=M/4 species, C=M/4 couples):
+ *  - create: edges (and couples) of every create_* mode, with the 
+ *    generators of net_tools (up to `ref_max` links) and generator=fast
+ *  - assemble: assembly of the coupled reactions (rm_assemble_coupled)
+ *  - write / sbml / read: jrnf and sbml files of a coupled ER network with
+ *    net_tools (write_jrnf_reaction_n, write_sbml_reaction_n,
+ *    read_jrnf_reaction_n) and jrnf_tools (write_network, write_sbml, 
+ *    read_network)
+ */
+
+void bench_suite(const vector<size_t>& sizes, size_t ref_max, size_t threads, const string& tmp) {
+    threads=thread_count(threads);
+
+    for(size_t j=0; j<sizes.size(); ++j) {
+        size_t M=sizes[j], N=max(sizes[j]/4, size_t(32)), C=M/4;
+
+        for(size_t i=0; i<create_modes().size(); ++i) 
+            for(size_t fast=0; fast<2; ++fast) {
+                create_para p;
+                p.mode=create_modes()[i].first;
+                p.N=N;
+                p.M=M;
+                p.C=p.is_coupled() ? C : 0;
+                p.alpha=0.1;
+                p.h=4;
+                p.m=16;
+                p.r=0.5;
+                p.fast=(fast == 1);
+                p.threads=threads;
+
+                if(!p.fast && M > ref_max)
+                    continue;
+
+                const char* impl=p.fast ? "jrnf_tools" : "net_tools";
+                edge_list edges, couples;
+                measure(bench_record("create", impl, p.mode, N, M, p.C), [&]() {
+                    create_edges(p, 1, edges, couples);
+                });
+
+                if(p.is_coupled() && p.fast)
+                    measure(bench_record("assemble", "jrnf_tools", p.mode, N, M, couples.size()), [&]() {
+                        count_sink cs;
+                        rn_rng rng(1);
+                        rm_assemble_coupled(cs, edges, couples, 0, rng);
+                    });
+            }
+
+        create_para p;
+        p.mode="create_ER_NM_bi_C";
+        p.N=N;
+        p.M=M;
+        p.C=C;
+        p.fast=true;
+        p.threads=threads;
+
+        rn_store st;
+        create_network(p, 1, st, false);
+        size_t R=st.reaction_count();
+
+        // files written by jrnf_tools (shortest round trip numbers)
+        output_precision()=0;
+        measure(bench_record("write", "jrnf_tools", p.mode, N, R, C), [&]() {  write_network(tmp, st);  }, tmp);
+        measure(bench_record("sbml", "jrnf_tools", p.mode, N, R, C), [&]() {  write_sbml(tmp+".xml", st, threads);  }, tmp+".xml");
+        measure(bench_record("read", "jrnf_tools", p.mode, N, R, C), [&]() {
+            rn_store in;
+            read_network(tmp, in);
+        }, tmp);
+
+        if(M > ref_max)
+            continue;
+
+        vector<species> sp;
+        vector<reaction> re;
+        st.to_vectors(sp, re);
+        measure(bench_record("write", "net_tools", p.mode, N, R, C), [&]() {  write_jrnf_reaction_n(tmp, sp, re);  }, tmp);
+        measure(bench_record("sbml", "net_tools", p.mode, N, R, C), [&]() {  write_sbml_reaction_n(tmp+".xml", sp, re);  }, tmp+".xml");
+        measure(bench_record("read", "net_tools", p.mode, N, R, C), [&]() {
+            vector<species> sp_in;
+            vector<reaction> re_in;
+            read_jrnf_reaction_n(tmp, sp_in, re_in);
+        }, tmp);
+    }
+
+    remove(tmp.c_str());
+    remove((tmp+".xml").c_str());
+}
+
+
+/*
+ * main
+ */
+
+int main(int argc, const char* argv[]) {
+    cl_para cl(argc, argv);
+
+    if(cl.have_param("coupling"))
+        bench_coupling(cl.have_param("erase_max") ? cl.get_param_i("erase_max") : 100000);
+
+    if(cl.have_param("read"))
+        bench_read(cl.have_param("max_M") ? cl.get_param_i("max_M") : 1000000,
+                   cl.have_param("tmp") ? cl.get_param("tmp") : "bench_tmp.jrnf");
+
+    if(cl.have_param("combine"))
+        bench_combine(cl.have_param("ref_max") ? cl.get_param_i("ref_max") : 10000);
+
+    size_t failed=0;
+    if(cl.have_param("transform_parity")) {
+        vector<string> files;
+        if(cl.have_param("files"))
+            split_species_list(cl.get_param("files"), files);
+        failed += bench_transform_parity(files);
+    }
+
+    if(cl.have_param("sbml_parity")) {
+        vector<string> files;
+        if(cl.have_param("files"))
+            split_species_list(cl.get_param("files"), files);
+        failed += bench_sbml_parity(files, cl.have_param("tmp") ? cl.get_param("tmp") : "bench_tmp.xml");
+    }
+
+    if(cl.have_param("er"))
+        bench_er(cl.have_param("max_M") ? cl.get_param_i("max_M") : 10000000,
+                 cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+
+    if(cl.have_param("ba"))
+        failed += bench_ba(cl.have_param("max_N") ? cl.get_param_i("max_N") : 10000000,
+                 cl.have_param("ref_max") ? cl.get_param_i("ref_max") : 1000000,
+                 cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+
+    if(cl.have_param("ws"))
+        bench_ws(cl.have_param("max_N") ? cl.get_param_i("max_N") : 10000000,
+                 cl.have_param("ref_max") ? cl.get_param_i("ref_max") : 1000000,
+                 cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+
+    if(cl.have_param("modular"))
+        bench_modular(cl.have_param("max_N") ? cl.get_param_i("max_N") : 10000000,
+                      cl.have_param("ref_max") ? cl.get_param_i("ref_max") : 1000000,
+                      cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+
+    if(cl.have_param("write"))
+        bench_write(cl.have_param("max_M") ? cl.get_param_i("max_M") : 10000000,
+                    cl.have_param("tmp") ? cl.get_param("tmp") : "bench_tmp.jrnf");
+
+    if(cl.have_param("suite")) {
+        vector<size_t> sizes;
+        vector<string> list;
+        split_species_list(cl.have_param("sizes") ? cl.get_param("sizes") : "10000,100000,1000000", list);
+        for(size_t i=0; i<list.size(); ++i)
+            sizes.push_back(strtoull(list[i].c_str(), 0, 10));
+
+        bench_suite(sizes, cl.have_param("ref_max") ? cl.get_param_i("ref_max") : 100000,
+                    cl.have_param("threads") ? cl.get_param_i("threads") : 0,
+                    cl.have_param("tmp") ? cl.get_param("tmp") : "bench_tmp.jrnf");
+    }
+
+    if(cl.have_param("help") || cl.have_param("info")) {
+        cout << "          jrnf_tools benchmarks" << endl;
+        cout << "          =====================" << endl;
+        cout << "-> coupling" << endl;
+        cout << " Assembly of coupled reactions from edge list (M=10^5..10^7)" << endl;
+        cout << " --> erase_max - largest M for which the erase based reference is run" << endl;
+        cout << endl;
+        cout << "-> read" << endl;
+        cout << " Reading jrnf-files with iostreams and memory mapped (M=10^5..max_M)" << endl;
+        cout << " --> max_M - largest number of reactions" << endl;
+        cout << " --> tmp - name of temporary file" << endl;
+        cout << endl;
+        cout << "-> combine" << endl;
+        cout << " Combining two networks with 10^4..10^6 species each" << endl;
+        cout << " --> ref_max - largest size for which combine_r_networks is timed" << endl;
+        cout << endl;
+        cout << "-> transform_parity" << endl;
+        cout << " Checks that removing species and combining networks give the same" << endl;
+        cout << " networks as net_tools (exit code 1 if not)" << endl;
+        cout << " --> files - comma separated jrnf-files (default: generated networks)" << endl;
+        cout << endl;
+        cout << "-> sbml_parity" << endl;
+        cout << " Checks that write_sbml and sbml_writer write the same files as" << endl;
+        cout << " write_sbml_reaction_n, byte for byte (exit code 1 if not)" << endl;
+        cout << " --> files - comma separated jrnf-files (default: random network)" << endl;
+        cout << " --> tmp - name of temporary file" << endl;
+        cout << endl;
+        cout << "-> er" << endl;
+        cout << " Erdos-Renyi generator: degree distribution compared to net_tools" << endl;
+        cout << " and time for M=10^6..max_M links" << endl;
+        cout << " --> max_M - largest number of links (default 10^7)" << endl;
+        cout << " --> threads - number of threads (default: all cores)" << endl;
+        cout << endl;
+        cout << "-> ba" << endl;
+        cout << " Barabasi-Albert generator compared to net_tools (N=10^6..max_N, M=2N)" << endl;
+        cout << " --> max_N - largest number of nodes (default 10^7)" << endl;
+        cout << " --> ref_max - largest N for which net_tools is timed (default 10^6)" << endl;
+        cout << " --> threads - number of threads (default: all cores)" << endl;
+        cout << endl;
+        cout << "-> ws" << endl;
+        cout << " Watts-Strogatz generator compared to net_tools (N=10^5..max_N, M=2N)" << endl;
+        cout << " and degree distribution compared for N=10^4" << endl;
+        cout << " --> max_N - largest number of nodes (default 10^7)" << endl;
+        cout << " --> ref_max - largest N for which net_tools is timed (default 10^6)" << endl;
+        cout << " --> threads - number of threads (default: all cores)" << endl;
+        cout << endl;
+        cout << "-> modular" << endl;
+        cout << " Hierarchical modular generator compared to net_tools (N=10^5..max_N)" << endl;
+        cout << " --> max_N - largest number of nodes (default 10^7)" << endl;
+        cout << " --> ref_max - largest N for which net_tools is timed (default 10^6)" << endl;
+        cout << " --> threads - number of threads (default: all cores)" << endl;
+        cout << endl;
+        cout << "-> write" << endl;
+        cout << " Writing jrnf-files with iostreams and to_chars and sbml (M=10^5..max_M)" << endl;
+        cout << " --> max_M - largest number of reactions (default 10^7)" << endl;
+        cout << " --> tmp - name of temporary file" << endl;
+        cout << endl;
+        cout << "-> suite" << endl;
+        cout << " All create_* modes (net_tools and fast generator), coupling assembly," << endl;
+        cout << " reading / writing jrnf and writing sbml (net_tools and jrnf_tools)." << endl;
+        cout << " One JSON object per measurement and line with time, throughput and" << endl;
+        cout << " peak memory (M links / reactions, N=M/4 species, C=M/4 couples)" << endl;
+        cout << " --> sizes - comma separated list of M (default 10000,100000,1000000)" << endl;
+        cout << " --> ref_max - largest M for which net_tools is run (default 10^5)" << endl;
+        cout << " --> threads - number of threads (default: all cores)" << endl;
+        cout << " --> tmp - name of temporary file" << endl;
+        cout << endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
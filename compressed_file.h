@@ -0,0 +1,312 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Transparent gzip compression of network files. Files whose name ends
+ * with ".gz" are written compressed (output_file), compressed input files
+ * are recognized by their content and decompressed in memory, as a whole
+ * or piece by piece while they are parsed (gunzip_stream, see input_file
+ * in jrnf_mmap.h), so the uncompressed file never is on disk.
+ *
+ * Output is compressed in blocks of 1 MB on several threads, every
+ * block is a gzip member of its own. Concatenated members are a valid gzip
+ * file (as written by pigz / "cat a.gz b.gz"), readable by gzip and zlib.
+ */
+
+#ifndef __JRNF_TOOLS_COMPRESSED_FILE_H__
+#define __JRNF_TOOLS_COMPRESSED_FILE_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <zlib.h>
+
+#include "thread_pool.h"
+
+
+inline bool is_gz_filename(const std::string& filename) {
+    return filename.size() >= 3 && filename.compare(filename.size()-3, 3, ".gz") == 0;
+}
+
+
+/*
+ * Returns `filename` without the ending ".gz" (if it has one).
+ */
+
+inline std::string strip_gz_filename(const std::string& filename) {
+    return is_gz_filename(filename) ? filename.substr(0, filename.size()-3) : filename;
+}
+
+
+inline bool is_gz_data(const char* b, const char* e) {
+    return e-b >= 2 && (unsigned char)b[0] == 0x1f && (unsigned char)b[1] == 0x8b;
+}
+
+
+/*
+ * Compresses [d, d+n) to one gzip member in `out` with compression level
+ * `level`. Returns false on errors.
+ */
+
+inline bool gzip_block(const char* d, size_t n, std::string& out, int level) {
+    z_stream z;
+    z.zalloc=Z_NULL;
+    z.zfree=Z_NULL;
+    z.opaque=Z_NULL;
+    if(deflateInit2(&z, level, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+
+    out.resize(deflateBound(&z, n));
+    z.next_in=(Bytef*)d;
+    z.avail_in=n;
+    z.next_out=(Bytef*)&out[0];
+    z.avail_out=out.size();
+
+    int r=deflate(&z, Z_FINISH);
+    out.resize(out.size()-z.avail_out);
+    deflateEnd(&z);
+    return r == Z_STREAM_END;
+}
+
+
+/*
+ * Decompresses gzip data (one or several members) piece by piece.
+ */
+
+class gunzip_stream {
+    z_stream z;
+    const char* b;
+    const char* e;
+    bool init, done, failed;
+
+    gunzip_stream(const gunzip_stream&);
+    gunzip_stream& operator=(const gunzip_stream&);
+
+public:
+    gunzip_stream() : b(0), e(0), init(false), done(true), failed(false) {}
+    ~gunzip_stream() {  close();  }
+
+    // Starts decompressing [begin, end) (has to stay valid until finished)
+    bool open(const char* begin, const char* end) {
+        close();
+        z.zalloc=Z_NULL;
+        z.zfree=Z_NULL;
+        z.opaque=Z_NULL;
+        z.next_in=(Bytef*)begin;
+        z.avail_in=0;
+        if(inflateInit2(&z, 15+16) != Z_OK)
+            return false;
+
+        init=true;
+        b=begin;
+        e=end;
+        done=failed=false;
+        return true;
+    }
+
+    void close() {
+        if(init)
+            inflateEnd(&z);
+        init=false;
+        done=true;
+    }
+
+    // All data is decompressed (or broken)
+    bool finished() const {  return done;  }
+
+
+    /*
+     * Appends up to `n` decompressed bytes to `out` (less only at the end
+     * of the data). Returns false if the data is broken.
+     */
+
+    bool read(std::string& out, size_t n) {
+        const size_t step=size_t(1) << 30;     // avail_in / avail_out are 32 bit
+        size_t used=out.size();
+        out.resize(used+n);
+
+        while(!done && used < out.size()) {
+            if(z.avail_in == 0 && b != e) {
+                size_t k=std::min(size_t(e-b), step);
+                z.next_in=(Bytef*)b;
+                z.avail_in=k;
+                b += k;
+            }
+
+            z.next_out=(Bytef*)&out[used];
+            z.avail_out=std::min(out.size()-used, step);
+            size_t before=z.avail_out;
+
+            int r=inflate(&z, Z_NO_FLUSH);
+            used += before-z.avail_out;
+
+            if(r == Z_STREAM_END) {
+                if(z.avail_in == 0 && b == e)
+                    done=true;
+                else if(inflateReset(&z) != Z_OK)   // next member
+                    done=failed=true;
+            } else if(r != Z_OK)                    // also truncated data
+                done=failed=true;
+        }
+
+        out.resize(used);
+        return !failed;
+    }
+};
+
+
+/*
+ * Decompresses the gzip data [b, e) (one or several members) to `out`.
+ * Returns false if the data is broken.
+ */
+
+inline bool gunzip(const char* b, const char* e, std::string& out) {
+    gunzip_stream z;
+    if(!z.open(b, e))
+        return false;
+
+    out.clear();
+    while(!z.finished())
+        if(!z.read(out, std::max(out.size(), size_t(1) << 22)))
+            return false;
+
+    return true;
+}
+
+
+/*
+ * Output file, written uncompressed or (name ending ".gz") as gzip. Parts
+ * written with write_fixed can be overwritten later (with data of the same
+ * size) by rewrite_fixed, for compressed files they are stored as a member
+ * without compression.
+ */
+
+class output_file {
+    std::ofstream out;
+    bool gz, ok;
+    size_t threads;
+    std::string cur;
+    std::vector<std::string> blocks, packed;
+
+    static constexpr size_t block_size=size_t(1) << 20;
+
+    void compress_blocks() {
+        packed.resize(blocks.size());
+        std::vector<uint8_t> good(blocks.size(), 0);
+        parallel_for(blocks.size(), threads, [&](size_t i) {
+            good[i]=gzip_block(blocks[i].data(), blocks[i].size(), packed[i], Z_DEFAULT_COMPRESSION);
+        });
+
+        for(size_t i=0; i<blocks.size(); ++i) {
+            ok = ok && good[i];
+            out.write(packed[i].data(), packed[i].size());
+        }
+        blocks.clear();
+    }
+
+    void flush() {
+        if(!cur.empty()) {
+            blocks.push_back(std::string());
+            blocks.back().swap(cur);
+        }
+        compress_blocks();
+    }
+
+    void put_fixed(const char* d, size_t n) {
+        if(!gz) {
+            out.write(d, n);
+            return;
+        }
+
+        std::string m;
+        ok = ok && gzip_block(d, n, m, Z_NO_COMPRESSION);
+        out.write(m.data(), m.size());
+    }
+
+public:
+    output_file() : gz(false), ok(true), threads(1) {}
+    ~output_file() {  close();  }
+
+    /*
+     * Opens `filename` (compressed if it ends with ".gz", blocks are
+     * compressed on `threads` threads, 0 - all cores).
+     */
+
+    bool open(const std::string& filename, size_t t=0) {
+        gz=is_gz_filename(filename);
+        ok=true;
+        threads=thread_count(t);
+        cur.clear();
+        blocks.clear();
+        out.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        return out.is_open();
+    }
+
+    bool is_open() const {  return out.is_open();  }
+
+    void write(const char* d, size_t n) {
+        if(!gz) {
+            out.write(d, n);
+            return;
+        }
+
+        cur.append(d, n);
+        if(cur.size() >= block_size) {
+            blocks.push_back(std::string());
+            blocks.back().swap(cur);
+            cur.reserve(block_size+(block_size >> 2));
+            if(blocks.size() >= 2*threads)
+                compress_blocks();
+        }
+    }
+
+    void write(const char* s) {
+        write(s, std::strlen(s));
+    }
+
+    void write(const std::string& s) {
+        write(s.data(), s.size());
+    }
+
+    // Returns the position to give to rewrite_fixed
+    size_t write_fixed(const char* d, size_t n) {
+        if(gz)
+            flush();
+
+        size_t pos=out.tellp();
+        put_fixed(d, n);
+        return pos;
+    }
+
+    void rewrite_fixed(size_t pos, const char* d, size_t n) {
+        if(gz)
+            flush();
+
+        std::streampos end=out.tellp();
+        out.seekp(pos);
+        put_fixed(d, n);
+        out.seekp(end);
+    }
+
+    /*
+     * Writes all buffered data and closes the file. Returns false if any
+     * write failed.
+     */
+
+    bool close() {
+        if(!out.is_open())
+            return true;
+
+        if(gz)
+            flush();
+        ok = ok && out.good();
+        out.close();
+        return ok;
+    }
+};
+
+
+#endif
@@ -0,0 +1,339 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Choosing the coupled link pairs of the "_bi_C" modes (alternative to the
+ * couple_* functions of net_tools, used with 'generator=fast'). The links
+ * that are still available are held in a swap-remove array, so drawing
+ * and removing a link is O(1). With limit_coupling the two links of a
+ * couple must not share a species (the reaction "A + B <--> C + D" has
+ * four different species, so self loops are never coupled); partners are
+ * found by rejection sampling with a bounded number of draws and, if all
+ * of them are rejected, by scanning the remaining links. Per species and
+ * per species pair counts of available links show when every remaining
+ * link shares a species with the first one, the search is skipped then.
+ *
+ * With `connected` the couples also join the connected components of the
+ * network: every link stays in one reaction with both of its species, so
+ * the components of the reaction network are those of the links, merged
+ * by the coupled pairs ("A + B <--> C + D" connects the components of
+ * "A - C" and "B - D"). Components are tracked with union-find and, before
+ * the random couples are drawn, each component is coupled to the ones
+ * already joined (largest first), so no network has to be generated again
+ * because it is not connected. Couples never split components, so the
+ * random couples drawn afterwards keep the network connected.
+ */
+
+#ifndef __JRNF_TOOLS_COUPLING_SAMPLER_H__
+#define __JRNF_TOOLS_COUPLING_SAMPLER_H__
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "rng.h"
+#include "edge_generators.h"
+#include "coupling_assembly.h"
+#include "union_find.h"
+
+
+/*
+ * Counters of one coupling run: partner candidates drawn and rejected
+ * (sharing a species with the first link), searches that had to scan the
+ * available links and first links for which no partner was found (they
+ * stay "A <--> B" reactions). With `connected` also the components
+ * (species without links not counted) before and after coupling and the
+ * couples formed to join them.
+ */
+
+struct coupling_stats {
+    size_t requested, coupled, draws, rejected, scans, dropped;
+    size_t components, components_after, bridges, isolated;
+
+    coupling_stats() : requested(0), coupled(0), draws(0), rejected(0), scans(0), dropped(0),
+                       components(0), components_after(0), bridges(0), isolated(0) {}
+
+    double rejection_rate() const {  return draws == 0 ? 0.0 : double(rejected)/double(draws);  }
+
+    void print(std::ostream& o) const {
+        o << "coupling: " << coupled << " of " << requested << " couples, "
+          << draws << " partner draws, " << rejected << " rejected (rate "
+          << rejection_rate() << "), " << scans << " scans, " << dropped << " links without partner" << std::endl;
+
+        if(components != 0) {
+            o << "connectivity: " << components << " components joined to " << components_after
+              << " by " << bridges << " couples";
+            if(isolated != 0)
+                o << ", " << isolated << " species without links";
+            o << std::endl;
+        }
+    }
+};
+
+
+/*
+ * The links of an edge list that are not coupled yet. Links are stored in
+ * a swap-remove array (with the position of every link), `degree` counts
+ * the available links of every species (self loops once). With `pairs`
+ * also the available links between every pair of species are counted
+ * (a-b and b-a together, multiple links), so touching() is exact.
+ */
+
+class link_pool {
+    const edge_list& edges;
+    std::vector<size_t> links, pos;
+    std::vector<size_t> degree;
+    std::vector<size_t> pair_of, pair_count;
+
+public:
+    link_pool(const edge_list& e, size_t N, bool pairs=false)
+        : edges(e), links(e.size()), pos(e.size()), degree(N, 0) {
+        for(size_t i=0; i<e.size(); ++i) {
+            links[i]=pos[i]=i;
+            ++degree[e[i].first];
+            if(e[i].second != e[i].first)
+                ++degree[e[i].second];
+        }
+
+        if(!pairs)
+            return;
+
+        std::vector< std::pair<std::pair<size_t, size_t>, size_t> > keys(e.size());
+        for(size_t i=0; i<e.size(); ++i)
+            keys[i]=std::make_pair(std::minmax(e[i].first, e[i].second), i);
+        std::sort(keys.begin(), keys.end());
+
+        pair_of.resize(e.size());
+        for(size_t i=0; i<keys.size(); ++i) {
+            if(i == 0 || keys[i].first != keys[i-1].first)
+                pair_count.push_back(0);
+            pair_of[keys[i].second]=pair_count.size()-1;
+            ++pair_count.back();
+        }
+    }
+
+    size_t size() const {  return links.size();  }
+    size_t at(size_t i) const {  return links[i];  }
+
+    // Number of available links sharing a species with link `l` (links
+    // between the same species are counted once only with `pairs`,
+    // otherwise this is an upper bound)
+    size_t touching(size_t l) const {
+        size_t a=edges[l].first, b=edges[l].second;
+        if(a == b)
+            return degree[a];
+
+        return degree[a] + degree[b] - (pair_count.empty() ? 0 : pair_count[pair_of[l]]);
+    }
+
+    void remove(size_t l) {
+        size_t p=pos[l], last=links.back();
+        links[p]=last;
+        pos[last]=p;
+        links.pop_back();
+
+        --degree[edges[l].first];
+        if(edges[l].second != edges[l].first)
+            --degree[edges[l].second];
+        if(!pair_count.empty())
+            --pair_count[pair_of[l]];
+    }
+};
+
+
+inline bool links_share_species(const std::pair<size_t, size_t>& x, const std::pair<size_t, size_t>& y) {
+    return x.first == y.first || x.first == y.second || x.second == y.first || x.second == y.second;
+}
+
+
+/*
+ * Returns an available link of `pool` that can be coupled with `l1` under
+ * limit_coupling (no self loop, no shared species) or edges.size() if
+ * there is none. The scan starts at a random position.
+ */
+
+template<typename rng_t>
+size_t scan_partner(const link_pool& pool, const edge_list& edges, size_t l1, rng_t& rng) {
+    size_t start=rng.below(pool.size());
+    for(size_t i=0; i<pool.size(); ++i) {
+        size_t c=pool.at((start+i) % pool.size());
+        if(edges[c].first != edges[c].second && !links_share_species(edges[l1], edges[c]))
+            return c;
+    }
+
+    return edges.size();
+}
+
+
+/*
+ * Couples links of different components of `edges` (network with N
+ * species) until all are joined or C couples are formed: components are
+ * taken by decreasing number of links, each one is coupled to a random link
+ * of the components joined so far. With `limit_coupling` self loops are
+ * never chosen (links of different components share no species). The
+ * chosen pairs are removed from `pool` and appended to `ids`. (A component
+ * can't be joined if all links of the joined ones are used - e.g. for
+ * isolated links - the next one starts a new group then; a component
+ * with only self loops isn't joined with `limit_coupling`.)
+ */
+
+template<typename rng_t>
+void join_components(std::vector< std::pair<size_t, size_t> >& ids, link_pool& pool, const edge_list& edges,
+                     size_t N, size_t C, bool limit_coupling, rng_t& rng, coupling_stats& st) {
+    union_find uf(N);
+    std::vector<bool> linked(N, false);
+    for(size_t i=0; i<edges.size(); ++i) {
+        uf.unite(edges[i].first, edges[i].second);
+        linked[edges[i].first]=linked[edges[i].second]=true;
+    }
+
+    // components (numbered by their root) and their links, ordered by size
+    std::vector<size_t> comp(N, N), count, order;
+    for(size_t s=0; s<N; ++s) {
+        if(!linked[s]) {
+            ++st.isolated;
+            continue;
+        }
+
+        size_t r=uf.find(s);
+        if(comp[r] == N) {
+            comp[r]=count.size();
+            count.push_back(0);
+        }
+    }
+
+    st.components=count.size();
+    for(size_t i=0; i<edges.size(); ++i)
+        ++count[comp[uf.find(edges[i].first)]];
+
+    order.resize(count.size());
+    for(size_t i=0; i<order.size(); ++i)
+        order[i]=i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {  return count[a] > count[b];  });
+
+    std::vector<size_t> offset(count.size()+1, 0), links(edges.size());
+    for(size_t i=0; i<count.size(); ++i)
+        offset[i+1]=offset[i]+count[i];
+    for(size_t i=0, c; i<edges.size(); ++i) {
+        c=comp[uf.find(edges[i].first)];
+        links[offset[c+1]-count[c]]=i;
+        --count[c];
+    }
+
+    // join the components one after another to the group of the largest
+    std::vector<size_t> group;
+    for(size_t j=0; j<order.size(); ++j) {
+        size_t b=offset[order[j]], n=offset[order[j]+1]-b, k=n;
+
+        // with limit_coupling only the first k links (no self loops) are used
+        if(limit_coupling)
+            k=std::partition(links.begin()+b, links.begin()+b+n, [&](size_t i) {
+                return edges[i].first != edges[i].second;
+            }) - (links.begin()+b);
+
+        if(j != 0 && !group.empty() && k != 0 && ids.size() < C) {
+            size_t g=rng.below(group.size()), l=b+rng.below(k);
+            size_t l1=group[g], l2=links[l];
+            group[g]=group.back();
+            group.pop_back();
+            links[l]=links[b+k-1];
+            links[b+k-1]=links[b+n-1];
+            --k;
+            --n;
+
+            pool.remove(l1);
+            pool.remove(l2);
+            ids.push_back(std::make_pair(l1, l2));
+            ++st.bridges;
+        }
+
+        group.insert(group.end(), links.begin()+b, links.begin()+b+k);
+    }
+
+    st.components_after=st.components-st.bridges;
+}
+
+
+/*
+ * Chooses up to C pairs of links of `edges` (network with N species) to
+ * be coupled, the random numbers are taken from `rng`. The first link of
+ * a couple is drawn uniformly from the available links, the second one
+ * as well. With `limit_coupling` self loops stay uncoupled and the second
+ * link is drawn at most `max_draws` times until it shares no species with
+ * the first; if all draws are rejected the available links are scanned
+ * for a partner. The first link stays uncoupled only if there is no
+ * partner for it. At most M/2 couples can be formed.
+ * With `connected` the components are joined first (see join_components).
+ *
+ * The couples are written to `couples` in the format of the couple_*
+ * functions of net_tools (ranks in the edge list after erasing the links
+ * of all previous couples, see rm_assemble_coupled).
+ */
+
+template<typename rng_t>
+coupling_stats couple_links(std::vector< std::pair<size_t, size_t> >& couples, const edge_list& edges,
+                            size_t N, size_t C, bool limit_coupling, bool connected, rng_t& rng,
+                            size_t max_draws=64) {
+    coupling_stats st;
+    st.requested=C;
+
+    link_pool pool(edges, N, limit_coupling);
+    std::vector< std::pair<size_t, size_t> > ids;
+    ids.reserve(std::min(C, edges.size()/2));
+
+    if(connected)
+        join_components(ids, pool, edges, N, C, limit_coupling, rng, st);
+
+    while(ids.size() < C && pool.size() >= 2) {
+        size_t l1=pool.at(rng.below(pool.size()));
+        pool.remove(l1);
+
+        size_t l2=edges.size();
+        if(!limit_coupling) {
+            l2=pool.at(rng.below(pool.size()));
+            ++st.draws;
+        } else if(edges[l1].first != edges[l1].second && pool.touching(l1) < pool.size()) {
+            for(size_t t=0; t<max_draws && l2 == edges.size(); ++t) {
+                size_t c=pool.at(rng.below(pool.size()));
+                ++st.draws;
+                if(edges[c].first == edges[c].second || links_share_species(edges[l1], edges[c]))
+                    ++st.rejected;
+                else
+                    l2=c;
+            }
+
+            if(l2 == edges.size()) {
+                ++st.scans;
+                l2=scan_partner(pool, edges, l1, rng);
+            }
+        }
+
+        if(l2 == edges.size()) {
+            ++st.dropped;
+            continue;
+        }
+
+        pool.remove(l2);
+        ids.push_back(std::make_pair(l1, l2));
+    }
+
+    // Translate to ranks: the couple is given with the link at the lower
+    // position first, so its rank is not changed by erasing the second one
+    rank_index ri(edges.size());
+    couples.clear();
+    couples.reserve(ids.size());
+    for(size_t i=0; i<ids.size(); ++i) {
+        size_t p1=std::min(ids[i].first, ids[i].second), p2=std::max(ids[i].first, ids[i].second);
+        couples.push_back(std::make_pair(ri.rank(p1), ri.rank(p2)));
+        ri.remove(p2);
+        ri.remove(p1);
+    }
+
+    st.coupled=couples.size();
+    return st;
+}
+
+
+#endif
@@ -0,0 +1,390 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * The network generating create_* modes of jrnf_tools. A network is
+ * described by its parameters (create_para) and a seed and can be
+ * generated into any network sink (see network_sink.h) - this is used for
+ * single networks as well as for ensembles generated in parallel.
+ */
+
+#ifndef __JRNF_TOOLS_CREATE_MODES_H__
+#define __JRNF_TOOLS_CREATE_MODES_H__
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <cstdlib>
+#include <cstdint>
+
+#include "net_tools/network_tools.h"
+#include "tools/cl_para.h"
+#include "reaction_macros.h"
+#include "coupling_assembly.h"
+#include "network_io.h"
+#include "edge_generators.h"
+#include "coupling_sampler.h"
+#include "rng.h"
+#include "profile.h"
+
+
+/*
+ * Parameters of a create_* mode (see help text in main.cpp).
+ */
+
+struct create_para {
+    std::string mode;
+    size_t N, M, C, m, h;
+    double alpha, r;
+    bool self_loop, directed, allow_multiple, limit_coupling;
+    bool connected;         // coupling joins the components (couple_links)
+    bool fast;              // use generators of edge_generators.h (if available)
+    size_t threads;         // threads of these generators
+    size_t batch;           // batch size of parallel preferential attachment (BA)
+
+    // Energy distribution of species and for activation energy
+    // TODO Not implemented yet
+    size_t energy_dist;     // 0 <-> linear [-1, 0]
+                            // 1 <-> logarithmic ln([0.01,1])
+    size_t aener_dist;      // 0 <-> linear [0, 1]
+                            // 1 <-> logarithmic -ln([0.01,1])
+
+    create_para() : N(0), M(0), C(0), m(0), h(0), alpha(0), r(0), self_loop(false),
+                    directed(false), allow_multiple(false), limit_coupling(false),
+                    connected(false), fast(false), threads(1), batch(1), energy_dist(0), aener_dist(0) {}
+
+    bool is_coupled() const {  return mode.size() > 5 && mode.compare(mode.size()-5, 5, "_bi_C") == 0;  }
+    bool has_model(const char* model) const {  return mode.compare(7, 2, model) == 0;  }
+    bool uses_alpha() const {  return has_model("WS");  }
+    bool uses_h() const {  return has_model("PS");  }
+    bool uses_mr() const {  return has_model("PS") || has_model("SM");  }
+};
+
+
+/*
+ * Names of all create_* modes and their default output files.
+ */
+
+inline const std::vector< std::pair<std::string, std::string> >& create_modes() {
+    static const std::vector< std::pair<std::string, std::string> > modes={
+        {"create_ER_NM", "ER_NM_network.jrnf"},
+        {"create_ER_NM_bi_C", "bi_nMC_network.jrnf"},
+        {"create_BA_NM", "BA_NM_network.jrnf"},
+        {"create_BA_NM_bi_C", "bi_NMC_network.jrnf"},
+        {"create_WS_NMalpha", "WS_NMalpha_network.jrnf"},
+        {"create_WS_NMalpha_bi_C", "bi_NMalphaC_network.jrnf"},
+        {"create_PS_NMhmr", "PS_NMhmr_network.jrnf"},
+        {"create_PS_NMhmr_bi_C", "PS_NMhmr_bi_C_network.jrnf"},
+        {"create_SM_NMmr_bi_C", "SM_NMmr_bi_C_network.jrnf"}
+    };
+    return modes;
+}
+
+
+/*
+ * Reads the parameters of create mode `mode` from the command line.
+ */
+
+inline create_para read_create_para(cl_para& cl, const std::string& mode) {
+    create_para p;
+    p.mode=mode;
+    p.N=cl.get_param_i("N");
+    p.M=cl.get_param_i("M");
+
+    if(p.is_coupled())
+        p.C=cl.get_param_i("C");
+
+    if(p.uses_alpha())
+        p.alpha=cl.get_param_d("alpha");
+
+    if(p.uses_h())
+        p.h=cl.get_param_i("h");
+
+    if(p.uses_mr()) {
+        p.m=cl.get_param_i("m");
+        p.r=cl.get_param_d("r");
+    }
+
+    p.self_loop=cl.have_param("self_loop");
+    p.directed=cl.have_param("directed");
+    p.allow_multiple=cl.have_param("allow_multiple");
+    p.limit_coupling=p.is_coupled() && cl.have_param("limit_coupling");
+    p.connected=p.is_coupled() && cl.have_param("connected");
+    // Networks of ensembles and sweeps are generated in parallel. The
+    // generators of net_tools use the global rand() state and run one at a
+    // time (see net_tools_mutex), so there the fast ones are the default.
+    bool many=cl.have_param("ensemble") || cl.have_param("sweep");
+    p.fast=cl.have_param("generator") ? cl.get_param("generator") == "fast" : many;
+    p.batch=cl.have_param("batch") ? cl.get_param_i("batch") : 1;
+    return p;
+}
+
+
+/*
+ * Prints the parameters of `p` (output file `out`) to `o`.
+ */
+
+inline void print_create_para(const create_para& p, const std::string& out, std::ostream& o) {
+    o << "mode: " << p.mode << "  N=" << p.N << "   M=" << p.M;
+
+    if(p.uses_alpha())
+        o << "    alpha=" << p.alpha;
+
+    if(p.uses_h())
+        o << "    h=" << p.h;
+
+    if(p.uses_mr())
+        o << "   m=" << p.m << "   r=" << p.r;
+
+    if(p.is_coupled())
+        o << "    C=" << p.C;
+
+    o << "   out=" << out << std::endl;
+
+    if(p.self_loop)
+        o << "self loop is active!" << std::endl;
+
+    if(p.directed)
+        o << "directed is active!" << std::endl;
+
+    if(p.allow_multiple)
+        o << "allow multiple is active!" << std::endl;
+
+    if(p.limit_coupling)
+        o << "limit coupling is active!" << std::endl;
+
+    if(p.connected)
+        o << "connected is active!" << std::endl;
+
+    if(p.fast) {
+        o << "fast generator is active (" << p.threads << " threads";
+        if(p.has_model("BA") && p.batch > 1)
+            o << ", batches of " << p.batch << " nodes";
+        o << ")!" << std::endl;
+    }
+
+    if(p.is_coupled()) {
+        o << "Energy distribution is " << p.energy_dist;
+        o << " and activation energy dist is " << p.aener_dist << std::endl;
+    }
+}
+
+
+/*
+ * The generators of net_tools use the global rand() state. They are only
+ * called with this mutex locked (after srand(seed)) so that networks
+ * generated in parallel are still determined by their seed. The calls of
+ * rand() are inside net_tools, so the lock is held for the whole
+ * generation and coupling: ensembles with 'generator=net_tools' are
+ * generated one network at a time (only the output runs in parallel).
+ */
+
+inline std::mutex& net_tools_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+
+/*
+ * Chooses the couples of the network described by `p` (seed `seed`) with
+ * couple_links. Warns if fewer than p.C couples were formed, the statistics
+ * are printed if `verbose` (or in this case).
+ */
+
+inline void couple_edges(const create_para& p, uint64_t seed,
+                         const std::vector< std::pair<size_t, size_t> >& edges,
+                         std::vector< std::pair<size_t, size_t> >& couples, bool verbose) {
+    // own stream, independent of the generators (stream 0 is used by
+    // create_network)
+    rn_rng rng(seed, ~uint64_t(0)-1);
+    coupling_stats st=couple_links(couples, edges, p.N, p.C, p.limit_coupling, p.connected, rng);
+    if(st.coupled < st.requested)
+        std::cout << "Warning: only " << st.coupled << " of " << st.requested << " couples formed!" << std::endl;
+    if(verbose || st.coupled < st.requested)
+        st.print(std::cout);
+}
+
+
+/*
+ * Generates the edge list (and for coupled modes the list of couples) of
+ * the network described by `p` with the seed `seed`. With `p.fast` the
+ * generators of edge_generators.h and couple_links are used, with
+ * `p.connected` couple_links also couples the links generated by net_tools.
+ * If `verbose` the statistics of the coupling are printed.
+ */
+
+inline void create_edges(const create_para& p, uint64_t seed,
+                         std::vector< std::pair<size_t, size_t> >& edges,
+                         std::vector< std::pair<size_t, size_t> >& couples, bool verbose=false) {
+    profile_phase ph("generate");
+
+    if(p.fast) {
+        if(p.has_model("ER"))
+            gen_erdos_renyi(edges, p.N, p.M, p.allow_multiple, p.self_loop, p.directed, seed, p.threads);
+        else if(p.has_model("BA"))
+            gen_barabasi_albert(edges, p.N, p.M, p.allow_multiple, p.self_loop, p.directed, seed, p.threads, p.batch);
+        else if(p.has_model("WS"))
+            gen_watts_strogatz(edges, p.N, p.M, p.alpha, p.allow_multiple, p.self_loop, p.directed, seed, p.threads);
+        else
+            gen_modular(edges, p.N, p.M, p.m, p.h, p.r, p.has_model("PS"), p.allow_multiple, p.self_loop, p.directed, seed, p.threads);
+
+        // ER and BA only generate the links that are possible
+        if((p.has_model("ER") || p.has_model("BA")) && edges.size() < p.M)
+            std::cout << "Warning: only " << edges.size() << " of " << p.M << " links are possible!" << std::endl;
+
+        if(p.is_coupled()) {
+            ph.next("coupling");
+
+            couple_edges(p, seed, edges, couples, verbose);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(net_tools_mutex());
+    srand((unsigned int)seed);
+
+    if(p.has_model("ER"))
+        create_erdos_renyi(edges, p.N, p.M, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("BA"))
+        create_barabasi_albert(edges, p.N, p.M, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("WS"))
+        create_watts_strogatz(edges, p.N, p.M, p.alpha, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("PS"))
+        create_pan_sinha(edges, p.N, p.M, p.h, p.m, p.r, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("SM"))
+        create_simple_modular(edges, p.N, p.M, p.m, p.r, p.allow_multiple, p.self_loop, p.directed);
+
+    if(!p.is_coupled())
+        return;
+
+    ph.next("coupling");
+
+    if(p.connected)
+        couple_edges(p, seed, edges, couples, verbose);
+    else if(p.has_model("ER"))
+        couple_erdos_renyi(couples, p.C, edges, p.limit_coupling, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("BA"))
+        couple_barabasi_albert(couples, p.C, edges, p.limit_coupling, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("WS"))
+        couple_watts_strogatz(couples, p.C, edges, p.alpha, p.limit_coupling, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("PS"))
+        couple_pan_sinha(couples, p.C, edges, p.h, p.m, p.r, p.limit_coupling, p.allow_multiple, p.self_loop, p.directed);
+    else if(p.has_model("SM"))
+        couple_simple_modular(couples, p.C, edges, p.m, p.r, p.limit_coupling, p.allow_multiple, p.self_loop, p.directed);
+}
+
+
+/*
+ * Passes the numbers of species and reactions of a generated network to
+ * the sink `s` before it is written, for the file writers as exact counts
+ * (so jrnf-files get the count line of write_jrnf_reaction_n).
+ */
+
+template<typename sink_t>
+void set_created_counts(sink_t& s, size_t sp_count, size_t re_count) {
+    s.reserve(sp_count, re_count);
+}
+
+inline void set_created_counts(network_writer& s, size_t sp_count, size_t re_count) {
+    s.set_counts(sp_count, re_count);
+}
+
+
+/*
+ * Generates the network described by `p` with seed `seed` into the network
+ * sink `s`. Uncoupled networks consist of reversible "A <-> B" reactions
+ * between species without energy, coupled networks of "A + B <-> C + D"
+ * reactions for the coupled links and "A <-> B" reactions for the others.
+ */
+
+template<typename sink_t>
+void create_network(const create_para& p, uint64_t seed, sink_t& s, bool verbose) {
+    if(verbose)
+        std::cout << "creating network (seed=" << seed << ")" << std::endl;
+
+    std::vector< std::pair<size_t, size_t> > edges, couples;
+    create_edges(p, seed, edges, couples, verbose);
+    profile_phase ph("output");
+    rn_rng rng(seed);
+
+    // every couple joins two links to one reaction
+    set_created_counts(s, p.N, edges.size()-(p.is_coupled() ? couples.size() : 0));
+
+    if(!p.is_coupled()) {
+        if(verbose)
+            std::cout << "Simple output!" << std::endl;
+
+        for(size_t t=0; t<p.N; ++t)
+            rm_add_species_ne(s, t);
+
+        for(size_t t=0; t<edges.size(); ++t)
+            rm_1to1rev(s, edges[t].first, edges[t].second);
+    } else {
+        if(verbose)
+            std::cout << "Output!" << std::endl;
+
+        for(size_t t=0; t<p.N; ++t)
+            rm_add_species(s, t, p.energy_dist, rng);
+
+        // Combine network links to "a+b->c+d"-reactions and translate all
+        // remaining links to unary reactions ("A->B")
+        rm_assemble_coupled(s, edges, couples, p.aener_dist, rng);
+    }
+}
+
+
+/*
+ * Generates the network described by `p` with seed `seed` and writes it to
+ * `out` (jrnf or jrnfb). Returns 0 on success.
+ */
+
+inline int create_network_file(const create_para& p, uint64_t seed, const std::string& out, bool verbose) {
+    network_writer w;
+    if(!w.open(out)) {
+        std::cout << "Error at opening " << out << " for writing!" << std::endl;
+        return 1;
+    }
+
+    create_network(p, seed, w, verbose);
+
+    profile_phase ph("output");
+    if(!w.close()) {
+        std::cout << "Error at writing network file " << out << "!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*
+ * Name of the `i`-th of `count` files of an ensemble: the (zero padded)
+ * number is inserted in front of the file ending of `out` (in front of the
+ * ending before ".gz" for compressed files).
+ */
+
+inline std::string ensemble_filename(const std::string& out, size_t i, size_t count) {
+    // the number goes before ".jrnf" / ".jrnfb" / ".xml", not before ".gz"
+    if(is_gz_filename(out))
+        return ensemble_filename(strip_gz_filename(out), i, count)+".gz";
+
+    size_t digits=1;
+    for(size_t c=count-1; c >= 10; c /= 10)
+        ++digits;
+
+    std::stringstream ss;
+    ss << "_" << std::setw(digits) << std::setfill('0') << i;
+
+    size_t dot=out.rfind('.');
+    size_t slash=out.rfind('/');
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return out+ss.str();
+
+    return out.substr(0, dot)+ss.str()+out.substr(dot);
+}
+
+
+#endif
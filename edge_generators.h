@@ -0,0 +1,908 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Parallel generators for the complex networks of the create_* modes
+ * (alternative to the generators of net_tools, parameter 'generator=fast').
+ * All random numbers come from rn_rng streams derived from the seed, work
+ * is split into a fixed number of blocks, so the generated network only
+ * depends on the seed and not on the number of threads.
+ */
+
+#ifndef __JRNF_TOOLS_EDGE_GENERATORS_H__
+#define __JRNF_TOOLS_EDGE_GENERATORS_H__
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "rng.h"
+#include "thread_pool.h"
+
+
+typedef std::vector< std::pair<size_t, size_t> > edge_list;
+
+
+/*
+ * The space of possible links between N nodes, ordered row by row. For
+ * undirected networks only pairs (a, b) with a <= b (a < b without self
+ * loops) are part of it.
+ */
+
+struct pair_space {
+    size_t N;
+    bool self_loop, directed;
+
+    pair_space(size_t n, bool sl, bool d) : N(n), self_loop(sl), directed(d) {}
+
+    uint64_t row_length(size_t a) const {
+        if(directed)
+            return self_loop ? N : N-1;
+        return self_loop ? N-a : N-a-1;
+    }
+
+    // Node at position `off` of row `a`
+    size_t column(size_t a, uint64_t off) const {
+        if(directed)
+            return (self_loop || off < a) ? off : off+1;
+        return self_loop ? a+off : a+1+off;
+    }
+
+    // Index of the first pair of row `a`
+    uint64_t row_start(size_t a) const {
+        uint64_t x=a;
+        if(directed)
+            return x*row_length(0);
+        return self_loop ? x*N-x*(x-1)/2 : x*(N-1)-x*(x-1)/2;
+    }
+
+    // Pair with index `i` (binary search over the rows)
+    std::pair<size_t, size_t> at(uint64_t i) const {
+        size_t lo=0, hi=N;
+        while(hi-lo > 1) {
+            size_t mid=lo+(hi-lo)/2;
+            if(row_start(mid) <= i)
+                lo=mid;
+            else
+                hi=mid;
+        }
+        return std::make_pair(lo, column(lo, i-row_start(lo)));
+    }
+
+    uint64_t size() const {
+        uint64_t n=N;
+        if(directed)
+            return self_loop ? n*n : n*(n-1);
+        return self_loop ? n*(n+1)/2 : n*(n-1)/2;
+    }
+
+    // Uniformly distributed pair of the space (N > 1 or self loops)
+    std::pair<size_t, size_t> random_pair(rn_rng& rng) const {
+        for(;;) {
+            size_t a=rng.below(N), b=rng.below(N);
+            if(a == b && (!self_loop || (!directed && rng.below(2) == 0)))
+                continue;   // undirected self loops are hit by only one ordered pair
+
+            if(!directed && a > b)
+                std::swap(a, b);
+            return std::make_pair(a, b);
+        }
+    }
+};
+
+
+/*
+ * Splits the rows of `s` into at most `blocks` consecutive ranges with
+ * about the same number of pairs. Returns the first rows, the last entry
+ * is s.N.
+ */
+
+inline std::vector<size_t> split_rows(const pair_space& s, size_t blocks) {
+    std::vector<size_t> first(1, 0);
+    uint64_t per_block=s.size()/blocks+1, in_block=0;
+
+    for(size_t a=0; a<s.N; ++a) {
+        in_block += s.row_length(a);
+        if(in_block >= per_block && a+1 < s.N) {
+            first.push_back(a+1);
+            in_block=0;
+        }
+    }
+
+    first.push_back(s.N);
+    return first;
+}
+
+
+/*
+ * Appends every pair of rows [r0, r1) of `s` to `out` with probability p,
+ * using geometrically distributed skips between chosen pairs (the runtime
+ * is proportional to the number of chosen pairs and rows).
+ */
+
+inline void skip_sample_rows(const pair_space& s, size_t r0, size_t r1, double p,
+                             rn_rng& rng, edge_list& out) {
+    double lq=std::log1p(-p);
+    size_t a=r0;
+    uint64_t off=0;
+
+    for(;;) {
+        // skip = number of pairs not chosen before the next chosen one
+        uint64_t skip=0;
+        if(p < 1.0) {
+            double g=std::floor(std::log1p(-rng.uniform())/lq);
+            skip=(g < 1.8e19) ? uint64_t(g) : ~uint64_t(0) >> 1;
+        }
+
+        off += skip;
+        while(a < r1 && off >= s.row_length(a)) {
+            off -= s.row_length(a);
+            ++a;
+        }
+
+        if(a >= r1)
+            return;
+
+        out.push_back(std::make_pair(a, s.column(a, off)));
+        ++off;
+    }
+}
+
+
+/*
+ * Appends all pairs of rows [r0, r1) of `s` that are not in the sorted
+ * list `excluded` to `out`.
+ */
+
+inline void complement_rows(const pair_space& s, size_t r0, size_t r1,
+                            const edge_list& excluded, edge_list& out) {
+    size_t j=0;
+    for(size_t a=r0; a<r1; ++a)
+        for(uint64_t off=0; off<s.row_length(a); ++off) {
+            std::pair<size_t, size_t> e(a, s.column(a, off));
+            if(j < excluded.size() && excluded[j] == e)
+                ++j;
+            else
+                out.push_back(e);
+        }
+}
+
+
+/*
+ * Draws exactly k distinct pairs of `s` (k <= s.size()) into the blocks of
+ * rows given by `first`, ordered as in `s`. Every block is skip sampled
+ * with a probability slightly above k/|s|, surplus pairs are removed
+ * uniformly afterwards (and sampling is repeated in the rare case of too
+ * few pairs), so every subset of size k is equally likely.
+ */
+
+inline void sample_distinct_pairs(const pair_space& s, const std::vector<size_t>& first, uint64_t k,
+                                  uint64_t seed, size_t threads, std::vector<edge_list>& parts) {
+    size_t blocks=first.size()-1;
+    double total=double(s.size());
+    uint64_t found=0;
+
+    parts.assign(blocks, edge_list());
+    if(k == 0)
+        return;
+
+    for(uint64_t attempt=0; found < k || attempt == 0; ++attempt) {
+        double p=std::min(1.0, (double(k)+4*std::sqrt(double(k))+16)*(1.0+attempt)/total);
+
+        parts.assign(blocks, edge_list());
+        parallel_for(blocks, threads, [&](size_t b) {
+            rn_rng rng(seed, ((attempt+1) << 32) + b);
+            skip_sample_rows(s, first[b], first[b+1], p, rng, parts[b]);
+        });
+
+        found=0;
+        for(size_t b=0; b<blocks; ++b)
+            found += parts[b].size();
+    }
+
+    // Remove found-k pairs chosen uniformly (mark them, then compact)
+    std::vector<bool> drop(found, false);
+    rn_rng rng(seed, ~uint64_t(0));
+    for(uint64_t d=found-k; d>0; ) {
+        uint64_t i=rng.below(found);
+        if(!drop[i]) {
+            drop[i]=true;
+            --d;
+        }
+    }
+
+    for(size_t b=0, base=0; b<blocks; ++b) {
+        size_t n=0;
+        for(size_t i=0; i<parts[b].size(); ++i)
+            if(!drop[base+i])
+                parts[b][n++]=parts[b][i];
+
+        base += parts[b].size();
+        parts[b].resize(n);
+    }
+}
+
+
+/*
+ * Concatenates `parts` to `edges` (in parallel).
+ */
+
+inline void concat_edges(std::vector<edge_list>& parts, edge_list& edges, size_t threads) {
+    std::vector<size_t> offset(parts.size()+1, 0);
+    for(size_t b=0; b<parts.size(); ++b)
+        offset[b+1]=offset[b]+parts[b].size();
+
+    edges.resize(offset.back());
+    parallel_for(parts.size(), threads, [&](size_t b) {
+        std::copy(parts[b].begin(), parts[b].end(), edges.begin()+offset[b]);
+        edge_list().swap(parts[b]);
+    });
+}
+
+
+/*
+ * Erdos-Renyi G(N, M) network with M links between N nodes (uniformly from
+ * all networks with M links). Without allow_multiple the links are distinct
+ * and ordered by their first and second node, for more than half of all
+ * possible links the complement is sampled. If M is larger than the number
+ * of possible links all of them are returned. Runs on `threads` threads.
+ */
+
+inline void gen_erdos_renyi(edge_list& edges, size_t N, size_t M, bool allow_multiple,
+                            bool self_loop, bool directed, uint64_t seed, size_t threads) {
+    const size_t blocks=64;
+    pair_space s(N, self_loop, directed);
+    edges.clear();
+
+    if(N == 0 || s.size() == 0 || M == 0)
+        return;
+
+    if(allow_multiple) {
+        const size_t chunk=size_t(1) << 20;
+        edges.resize(M);
+        parallel_for((M+chunk-1)/chunk, threads, [&](size_t b) {
+            rn_rng rng(seed, b+1);
+            for(size_t i=b*chunk; i<std::min(M, (b+1)*chunk); ++i)
+                edges[i]=s.random_pair(rng);
+        });
+        return;
+    }
+
+    uint64_t k=std::min<uint64_t>(M, s.size());
+    bool dense=(k > s.size()/2);
+    std::vector<size_t> first=split_rows(s, blocks);
+    std::vector<edge_list> parts;
+
+    sample_distinct_pairs(s, first, dense ? s.size()-k : k, seed, threads, parts);
+
+    if(dense) {
+        std::vector<edge_list> excluded;
+        excluded.swap(parts);
+        parts.resize(excluded.size());
+        parallel_for(excluded.size(), threads, [&](size_t b) {
+            complement_rows(s, first[b], first[b+1], excluded[b], parts[b]);
+            edge_list().swap(excluded[b]);
+        });
+    }
+
+    concat_edges(parts, edges, threads);
+}
+
+
+/*
+ * Barabasi-Albert network: nodes are added one after another, node t links
+ * to earlier nodes chosen with probability proportional to their degree+1
+ * (all nodes start with attractiveness 1, for directed networks only the
+ * in-degree counts). The M links are distributed evenly over the nodes 1..
+ * N-1 (links that are impossible without allow_multiple are given to the
+ * next nodes, what is left at the end to the last nodes with room; if M is
+ * larger than the number of possible links only those are generated, see
+ * create_edges). Choosing a node is O(1): a node is drawn as a random entry
+ * of the array holding every node once plus every link endpoint. Repeated
+ * targets are rejected through a small hash set of the node's targets; if a
+ * node links to more than half of the earlier nodes its targets are instead
+ * drawn at once without replacement (O(t log n) per node instead of many
+ * rejections).
+ *
+ * With `batch` > 1 the nodes of a batch choose their links in parallel on
+ * `threads` threads from the state before the batch (links within a batch
+ * are not preferred), otherwise the sequential model is exact. The result
+ * only depends on the seed and the batch size.
+ */
+
+inline void gen_barabasi_albert(edge_list& edges, size_t N, size_t M, bool allow_multiple,
+                                bool self_loop, bool directed, uint64_t seed,
+                                size_t threads, size_t batch=1) {
+    edges.clear();
+    if(N == 0)
+        return;
+
+    // Number of links of each node and their offset in `edges`
+    std::vector<size_t> first(N+1, 0);
+    uint64_t carry=0;
+    for(size_t t=0; t<N; ++t) {
+        uint64_t quota=(N == 1) ? M : uint64_t(M)*t/(N-1) - (t == 0 ? 0 : uint64_t(M)*(t-1)/(N-1));
+        uint64_t avail=t+(self_loop ? 1 : 0);
+        if(allow_multiple && avail > 0)
+            avail=~uint64_t(0);
+
+        uint64_t n=std::min(quota+carry, avail);
+        carry=quota+carry-n;
+        first[t+1]=n;
+    }
+
+    // Links left at the end go to the last nodes that still have room
+    for(size_t t=N; t-- > 0 && carry > 0; ) {
+        uint64_t room=t+(self_loop ? 1 : 0)-first[t+1];
+        uint64_t n=std::min(carry, room);
+        first[t+1] += n;
+        carry -= n;
+    }
+
+    for(size_t t=0; t<N; ++t)
+        first[t+1] += first[t];
+
+    edges.resize(first[N]);
+    std::vector<size_t> ends;      // every node once + all preferred link endpoints
+    ends.reserve(N+(directed ? 1 : 2)*edges.size());
+    std::vector<size_t> weight(N, 0);  // occurrences of each node in ends
+    if(batch == 0)
+        batch=1;
+
+    for(size_t t0=0, t1; t0<N; t0=t1) {
+        // Later nodes of a batch only see the nodes before t0, so they
+        // can't have more (distinct) links than that
+        t1=t0+1;
+        while(t0 > 0 && t1 < std::min(N, t0+batch) && (allow_multiple || first[t1+1]-first[t1] <= t0))
+            ++t1;
+
+        size_t snap=ends.size();
+
+        auto choose=[&](size_t t) {
+            rn_rng rng(seed, t+1);
+            size_t b=first[t], n=first[t+1]-first[t];
+
+            if(!allow_multiple && t >= 64 && 2*n > t) {
+                // Nearly every earlier node is linked, so instead of drawing
+                // and rejecting, the links are chosen as the n largest keys
+                // log(u)/w of all candidates (Efraimidis-Spirakis), which is
+                // the same as drawing without replacement proportional to w.
+                std::vector< std::pair<double, size_t> > keys;
+                keys.reserve(t+1);
+                for(size_t v=0; v<t; ++v)
+                    if(weight[v] != 0)
+                        keys.push_back(std::make_pair(std::log(1.0-rng.uniform())/double(weight[v]), v));
+                if(self_loop)
+                    keys.push_back(std::make_pair(std::log(1.0-rng.uniform()), t));
+
+                std::partial_sort(keys.begin(), keys.begin()+n, keys.end(),
+                                  std::greater< std::pair<double, size_t> >());
+                for(size_t i=0; i<n; ++i)
+                    edges[b+i]=std::make_pair(t, keys[i].second);
+                return;
+            }
+
+            // Targets already chosen by t (open addressing, only needed if
+            // there are more than a few)
+            thread_local std::vector<size_t> chosen;
+            size_t mask=0;
+            if(!allow_multiple && n > 16) {
+                for(mask=1; mask < 2*n; mask*=2) ;
+                chosen.assign(mask--, size_t(-1));
+            }
+
+            for(size_t i=b; i<b+n; ++i) {
+                size_t target;
+                bool again;
+                do {
+                    // the additional last index is node t itself (self loop)
+                    uint64_t r=rng.below(snap+(self_loop ? 1 : 0));
+                    target=(r == snap) ? t : ends[r];
+
+                    again=false;
+                    if(mask != 0) {
+                        size_t h=(target*0x9e3779b97f4a7c15ull >> 17) & mask;
+                        while(chosen[h] != size_t(-1) && chosen[h] != target)
+                            h=(h+1) & mask;
+                        again=(chosen[h] == target);
+                        chosen[h]=target;
+                    } else
+                        for(size_t j=b; j<i && !again && !allow_multiple; ++j)
+                            again=(edges[j].second == target);
+                } while(again);
+
+                edges[i]=std::make_pair(t, target);
+            }
+        };
+
+        if(t1-t0 == 1)
+            choose(t0);
+        else
+            parallel_for(t1-t0, threads, [&](size_t j) {  choose(t0+j);  });
+
+        for(size_t t=t0; t<t1; ++t) {
+            ends.push_back(t);
+            for(size_t i=first[t]; i<first[t+1]; ++i) {
+                if(!directed)
+                    ends.push_back(edges[i].first);
+                ends.push_back(edges[i].second);
+            }
+        }
+
+        for(size_t i=snap; i<ends.size(); ++i)
+            ++weight[ends[i]];
+    }
+}
+
+
+/*
+ * Set of links with O(1) expected insert / find / erase. Links are packed
+ * to 64 bit keys (node ids below 2^32), open addressing with linear 
+ * probing; erased slots are marked and reused. (Can also hold any keys
+ * below 2^64-2 with insert_key.)
+ */
+
+class edge_set {
+    static constexpr uint64_t empty=~uint64_t(0), erased=~uint64_t(0)-1;
+    std::vector<uint64_t> slots;
+    size_t mask, used;      // used: occupied + erased slots
+    bool directed;
+
+    static uint64_t mix(uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        return k ^ (k >> 33);
+    }
+
+    void grow() {
+        std::vector<uint64_t> old;
+        old.swap(slots);
+        slots.assign(2*old.size(), empty);
+        mask=slots.size()-1;
+        used=0;
+
+        for(size_t i=0; i<old.size(); ++i)
+            if(old[i] != empty && old[i] != erased)
+                place(old[i]);
+    }
+
+    bool place(uint64_t k) {
+        size_t i=mix(k) & mask, free=slots.size();
+        for(; slots[i] != empty; i=(i+1) & mask) {
+            if(slots[i] == k)
+                return false;
+            if(slots[i] == erased && free == slots.size())
+                free=i;
+        }
+
+        if(free == slots.size()) {
+            free=i;
+            ++used;
+        }
+        slots[free]=k;
+        return true;
+    }
+
+public:
+    edge_set(size_t expected, bool dir) : directed(dir) {
+        size_t size=16;
+        while(size < 2*expected)
+            size *= 2;
+
+        slots.assign(size, empty);
+        mask=size-1;
+        used=0;
+    }
+
+    uint64_t key(size_t a, size_t b) const {
+        if(!directed && a > b)
+            std::swap(a, b);
+        return (uint64_t(a) << 32) | uint64_t(b);
+    }
+
+    bool contains(size_t a, size_t b) const {
+        uint64_t k=key(a, b);
+        for(size_t i=mix(k) & mask; slots[i] != empty; i=(i+1) & mask)
+            if(slots[i] == k)
+                return true;
+        return false;
+    }
+
+    // Returns false if the key / link is already in the set
+    bool insert_key(uint64_t k) {
+        if(2*(used+1) > slots.size())
+            grow();
+        return place(k);
+    }
+
+    bool insert(size_t a, size_t b) {
+        return insert_key(key(a, b));
+    }
+
+    void erase(size_t a, size_t b) {
+        uint64_t k=key(a, b);
+        for(size_t i=mix(k) & mask; slots[i] != empty; i=(i+1) & mask)
+            if(slots[i] == k) {
+                slots[i]=erased;
+                return;
+            }
+    }
+};
+
+
+/*
+ * Watts-Strogatz network: ring lattice of M links (every node is linked to
+ * its next, then second next, ... neighbour) of which every link is rewired
+ * with probability alpha to a new, uniformly chosen second node (no self
+ * loops and multiple links unless allowed). If no new node is found after
+ * 1000 draws the link is kept.
+ *
+ * The random numbers of link i are taken from stream i. The rewired links
+ * are grouped by their (fixed) first node and the groups are rewired in
+ * parallel on `threads` threads, each in link order against the lattice
+ * and its own changes. For directed networks this is the sequential
+ * algorithm. For undirected ones a group doesn't see the changes of the
+ * others: a pair left by the other node's group can't be taken and two
+ * groups may choose the same pair, then the later link is rewired again
+ * (stream M+i) in a short sequential pass against all links (if no node is
+ * found it keeps its old node or takes the first free one). The result
+ * doesn't depend on `threads`.
+ */
+
+inline void gen_watts_strogatz(edge_list& edges, size_t N, size_t M, double alpha, bool allow_multiple,
+                               bool self_loop, bool directed, uint64_t seed, size_t threads) {
+    edges.clear();
+    if(N < 2)
+        return;
+
+    // Ring lattice
+    edge_set set(M, directed);
+    edges.reserve(M);
+    for(size_t dist=1; dist<N && edges.size()<M; ++dist)
+        for(size_t a=0; a<N && edges.size()<M; ++a)
+            if(set.insert(a, (a+dist) % N) || allow_multiple)
+                edges.push_back(std::make_pair(a, (a+dist) % N));
+
+    // Rewiring decisions and first candidates
+    const size_t chunk=size_t(1) << 16;
+    const size_t none=~size_t(0);
+    std::vector<size_t> cand(edges.size());
+
+    parallel_for((edges.size()+chunk-1)/chunk, threads, [&](size_t b) {
+        for(size_t i=b*chunk; i<std::min(edges.size(), (b+1)*chunk); ++i) {
+            rn_rng rng(seed, i+1);
+            cand[i]=(rng.uniform() < alpha) ? rng.below(N) : none;
+        }
+    });
+
+    // Rewired links grouped by first node: idx[off[a], off[a+1]) in order
+    std::vector<size_t> off(N+1, 0), idx;
+    for(size_t i=0; i<edges.size(); ++i)
+        if(cand[i] != none)
+            ++off[edges[i].first+1];
+    for(size_t a=0; a<N; ++a)
+        off[a+1] += off[a];
+
+    idx.resize(off[N]);
+    std::vector<size_t> pos(off.begin(), off.end()-1);
+    for(size_t i=0; i<edges.size(); ++i)
+        if(cand[i] != none)
+            idx[pos[edges[i].first]++]=i;
+
+    // New (with link) and old second nodes of the changed links of every
+    // group, sorted (none for links that are kept)
+    std::vector< std::pair<size_t, size_t> > added(idx.size());
+    std::vector<size_t> removed(idx.size()), old(idx.size());
+    const size_t nodes=size_t(1) << 12;
+
+    parallel_for((N+nodes-1)/nodes, threads, [&](size_t g) {
+        size_t a0=g*nodes, a1=std::min(N, (g+1)*nodes);
+        edge_set add(allow_multiple ? 0 : off[a1]-off[a0], true), rem(allow_multiple ? 0 : off[a1]-off[a0], true);
+
+        for(size_t a=a0; a<a1; ++a) {
+            for(size_t p=off[a]; p<off[a+1]; ++p) {
+                size_t i=idx[p], b=edges[i].second, c=cand[i];
+                old[p]=b;
+                added[p]=std::make_pair(none, i);
+                removed[p]=none;
+
+                rn_rng rng;
+                for(size_t n=0; n<1000; ++n) {
+                    if(n == 1) {            // continue stream i after the first candidate
+                        rng.seed(seed, i+1);
+                        rng.uniform();
+                        rng.below(N);
+                    }
+                    if(n > 0)
+                        c=rng.below(N);
+
+                    if((c != a || self_loop) &&
+                       (allow_multiple || !((set.contains(a, c) && !rem.contains(a, c)) || add.contains(a, c)))) {
+                        if(!allow_multiple) {
+                            rem.insert(a, b);
+                            add.insert(a, c);
+                        }
+                        edges[i].second=c;
+                        added[p]=std::make_pair(c, i);
+                        removed[p]=b;
+                        break;
+                    }
+                }
+            }
+
+            std::sort(added.begin()+off[a], added.begin()+off[a+1]);
+            std::sort(removed.begin()+off[a], removed.begin()+off[a+1]);
+        }
+    });
+
+    if(directed || allow_multiple)
+        return;
+
+    // Link added by group a to c (none if there is none)
+    auto added_by=[&](size_t a, size_t c) {
+        std::vector< std::pair<size_t, size_t> >::const_iterator e=added.begin()+off[a+1],
+            it=std::lower_bound(added.cbegin()+off[a], e, std::make_pair(c, size_t(0)));
+        return (it != e && it->first == c) ? it->second : none;
+    };
+
+    auto removed_by=[&](size_t a, size_t b) {
+        return std::binary_search(removed.begin()+off[a], removed.begin()+off[a+1], b);
+    };
+
+    // Links whose pair was also chosen by an earlier link of the other group
+    std::vector<char> again(idx.size(), 0);
+    parallel_for((idx.size()+chunk-1)/chunk, threads, [&](size_t b) {
+        for(size_t p=b*chunk; p<std::min(idx.size(), (b+1)*chunk); ++p) {
+            size_t c=added[p].first, i=added[p].second, a=edges[i].first;
+            again[p]=(c != none && c != a && added_by(c, a) < i);
+        }
+    });
+
+    std::vector<size_t> later;
+    for(size_t p=0; p<idx.size(); ++p)
+        if(again[p])
+            later.push_back(added[p].second);
+    std::sort(later.begin(), later.end());
+
+    edge_set late(later.size(), directed);
+    auto taken=[&](size_t a, size_t c) {
+        return (c == a && !self_loop) ||
+               (set.contains(a, c) && !removed_by(a, c) && !removed_by(c, a)) ||
+               added_by(a, c) != none || added_by(c, a) != none || late.contains(a, c);
+    };
+
+    for(size_t j=0; j<later.size(); ++j) {
+        size_t i=later[j], a=edges[i].first, c=none;
+        rn_rng rng(seed, edges.size()+i+1);
+        for(size_t n=0; n<1000 && c == none; ++n) {
+            size_t d=rng.below(N);
+            if(!taken(a, d))
+                c=d;
+        }
+
+        size_t b=old[std::lower_bound(idx.begin()+off[a], idx.begin()+off[a+1], i)-idx.begin()];
+        if(c == none && !taken(a, b))
+            c=b;
+        for(size_t d=0; d<N && c == none; ++d)
+            if(!taken(a, d))
+                c=d;
+
+        if(c != none) {
+            edges[i].second=c;
+            late.insert(a, c);
+        }
+    }
+}
+
+
+/*
+ * Part of the pair space of a modular network: the pairs inside a module
+ * (`module`, nodes [base, base+L)) or between two neighbouring blocks of
+ * modules (nodes [base, base+L) and [base+L, base+L+R)). Pieces of it are
+ * given by ranges of the pair index.
+ */
+
+struct modular_unit {
+    size_t base, L, R;
+    bool module;
+    double weight;
+    uint64_t size, begin, end, quota;
+
+    std::pair<size_t, size_t> at(const pair_space& in_module, uint64_t i) const {
+        if(module) {
+            std::pair<size_t, size_t> e=in_module.at(i);
+            return std::make_pair(base+e.first, base+e.second);
+        }
+
+        uint64_t lr=uint64_t(L)*R;
+        if(i < lr)
+            return std::make_pair(base+i/R, base+L+i%R);
+        i -= lr;        // directed: links from right to left block
+        return std::make_pair(base+L+i%R, base+i/R);
+    }
+};
+
+
+/*
+ * Distributes `total` over the entries of `quota` proportional to `share`
+ * (largest remainder, ties to the first entries). Entries are limited to
+ * `cap` if it is given, the rest is distributed over the others.
+ */
+
+inline void allocate_quotas(uint64_t total, const std::vector<double>& share,
+                            const std::vector<uint64_t>* cap, std::vector<uint64_t>& quota) {
+    size_t n=share.size();
+    quota.assign(n, 0);
+    std::vector<bool> full(n, false);
+
+    for(bool again=true; again; ) {
+        again=false;
+        double sum=0;
+        for(size_t i=0; i<n; ++i)
+            if(!full[i])
+                sum += share[i];
+
+        if(sum <= 0)
+            return;
+
+        for(size_t i=0; i<n && cap; ++i)
+            if(!full[i] && double(total)*share[i]/sum >= double((*cap)[i])) {
+                full[i]=true;
+                quota[i]=(*cap)[i];
+                total -= quota[i];
+                again=true;
+            }
+
+        if(again)
+            continue;
+
+        std::vector< std::pair<double, size_t> > rest;
+        uint64_t given=0;
+        for(size_t i=0; i<n; ++i)
+            if(!full[i]) {
+                double q=double(total)*share[i]/sum;
+                quota[i]=uint64_t(q);
+                given += quota[i];
+                rest.push_back(std::make_pair(-(q-double(quota[i])), i));
+            }
+
+        std::stable_sort(rest.begin(), rest.end());
+        for(size_t j=0; j<rest.size() && given < total; ++j, ++given)
+            ++quota[rest[j].second];
+    }
+}
+
+
+/*
+ * Hierarchical modular network (Pan-Sinha like): the N nodes form modules
+ * of m nodes, neighbouring modules are combined to blocks of 2, 4, 8, ...
+ * modules (levels 1, 2, 3, ...). The M links are distributed with a 
+ * weight per pair given by the level on which both nodes are combined
+ * first: 1 inside modules, r^l on level l (r^h above level h) if 
+ * `hierarchical`, otherwise r for all pairs of different modules (simple
+ * modular network).
+ *
+ * The number of links of every module and every pair of neighbouring 
+ * blocks is computed up front (proportional to weight and number of 
+ * pairs, limited to the number of pairs without allow_multiple). Large
+ * ones are split into pieces of the pair index range and all pieces are
+ * filled independently (own rn_rng stream each, distinct pairs by Floyd's
+ * algorithm) on `threads` threads.
+ */
+
+inline void gen_modular(edge_list& edges, size_t N, size_t M, size_t m, size_t h, double r,
+                        bool hierarchical, bool allow_multiple, bool self_loop, bool directed,
+                        uint64_t seed, size_t threads) {
+    edges.clear();
+    if(N == 0 || M == 0)
+        return;
+
+    if(m == 0 || m > N)
+        m=N;
+
+    // Modules and blocks of the hierarchy (recursive splitting of the
+    // module range [lo, hi) at the largest power of two below hi-lo)
+    size_t modules=(N+m-1)/m;
+    pair_space in_module(m, self_loop, directed), last_module(N-(modules-1)*m, self_loop, directed);
+    std::vector<modular_unit> units;
+    std::vector< std::pair<size_t, size_t> > todo(1, std::make_pair(size_t(0), modules));
+
+    while(!todo.empty()) {
+        size_t lo=todo.back().first, hi=todo.back().second;
+        todo.pop_back();
+
+        modular_unit u;
+        u.base=lo*m;
+        u.begin=0;
+
+        if(hi-lo == 1) {
+            u.module=true;
+            u.L=std::min(N, hi*m)-u.base;
+            u.R=0;
+            u.weight=1.0;
+            u.size=(hi == modules ? last_module : in_module).size();
+        } else {
+            size_t level=1;
+            while((size_t(1) << level) < hi-lo)
+                ++level;
+
+            size_t mid=lo+(size_t(1) << (level-1));
+            u.module=false;
+            u.L=(mid-lo)*m;
+            u.R=std::min(N, hi*m)-mid*m;
+            u.weight=hierarchical ? std::pow(r, double(std::min(level, h))) : r;
+            u.size=uint64_t(u.L)*u.R*(directed ? 2 : 1);
+
+            todo.push_back(std::make_pair(lo, mid));
+            todo.push_back(std::make_pair(mid, hi));
+        }
+
+        u.end=u.size;
+        if(u.size > 0)
+            units.push_back(u);
+    }
+
+    // Quotas, then split into pieces of at most 2^16 links
+    std::vector<double> share(units.size());
+    std::vector<uint64_t> cap(units.size()), quota;
+    for(size_t i=0; i<units.size(); ++i) {
+        share[i]=units[i].weight*double(units[i].size);
+        cap[i]=units[i].size;
+    }
+    allocate_quotas(M, share, allow_multiple ? 0 : &cap, quota);
+
+    const uint64_t piece=uint64_t(1) << 16;
+    std::vector<modular_unit> pieces;
+    for(size_t i=0; i<units.size(); ++i) {
+        uint64_t n=(quota[i]+piece-1)/piece;
+        std::vector<double> p_share(n);
+        std::vector<uint64_t> p_cap(n), p_quota;
+        for(uint64_t j=0; j<n; ++j) {
+            p_cap[j]=units[i].size/n+(j+1 == n ? units[i].size%n : 0);
+            p_share[j]=double(p_cap[j]);
+        }
+        allocate_quotas(quota[i], p_share, allow_multiple ? 0 : &p_cap, p_quota);
+
+        for(uint64_t j=0; j<n; ++j) {
+            modular_unit p=units[i];
+            p.begin=units[i].size/n*j;
+            p.end=p.begin+p_cap[j];
+            p.quota=p_quota[j];
+            pieces.push_back(p);
+        }
+    }
+
+    std::vector<size_t> offset(pieces.size()+1, 0);
+    for(size_t i=0; i<pieces.size(); ++i)
+        offset[i+1]=offset[i]+pieces[i].quota;
+    edges.resize(offset.back());
+
+    parallel_for(pieces.size(), threads, [&](size_t i) {
+        const modular_unit& p=pieces[i];
+        const pair_space& ps=(p.base+p.L == N && p.module) ? last_module : in_module;
+        uint64_t size=p.end-p.begin;
+        rn_rng rng(seed, i+1);
+
+        if(allow_multiple) {
+            for(uint64_t j=0; j<p.quota; ++j)
+                edges[offset[i]+j]=p.at(ps, p.begin+rng.below(size));
+        } else {
+            // Floyd: k distinct indices of [0, size)
+            edge_set chosen(p.quota, true);
+            for(uint64_t j=size-p.quota, n=0; j<size; ++j, ++n) {
+                uint64_t t=rng.below(j+1);
+                if(!chosen.insert_key(t)) {
+                    t=j;
+                    chosen.insert_key(t);
+                }
+                edges[offset[i]+n]=p.at(ps, p.begin+t);
+            }
+        }
+    });
+}
+
+
+#endif
@@ -0,0 +1,219 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Export of the species - reaction incidence (stoichiometric) matrix of a
+ * network for numerical code. Rows are species, columns reactions, an
+ * entry exists for every species taking part in a reaction and holds its
+ * multiplicity as educt and as product (the stoichiometric coefficient
+ * is product - educt, catalysts are entries with both set).
+ *
+ * Binary file (little endian, all arrays 8 byte, ready for mmap):
+ *   header (64 bytes): "JRNFI001", #species, #reactions, #entries (all
+ *                      uint64, rest zero)
+ *   CSC: column offsets (uint64, #reactions+1), row = species (uint64),
+ *        educt and product multiplicities (int64, one array each)
+ *   CSR: row offsets (uint64, #species+1), column = reaction (uint64),
+ *        educt and product multiplicities (int64, one array each)
+ * Rows in a column and columns in a row are sorted ascending. The Matrix
+ * Market file holds the stoichiometric coefficients (coordinate, integer,
+ * 1-based; catalysts as explicit zeros, so the pattern is the same).
+ */
+
+#ifndef __JRNF_TOOLS_INCIDENCE_MATRIX_H__
+#define __JRNF_TOOLS_INCIDENCE_MATRIX_H__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+#include "compressed_file.h"
+#include "jrnf_binary.h"
+#include "thread_pool.h"
+
+
+/*
+ * Incidence matrix of a network. Is a network sink (see network_sink.h),
+ * columns are added with every reaction, the rows are built by finish().
+ */
+
+class incidence_matrix {
+public:
+    uint64_t sp_count;
+    std::vector<uint64_t> col_off, row;
+    std::vector<int64_t> col_educt, col_product;
+    std::vector<uint64_t> row_off, col;
+    std::vector<int64_t> row_educt, row_product;
+
+private:
+    struct entry {
+        uint64_t species;
+        int64_t educt, product;
+        bool operator<(const entry& o) const {  return species < o.species;  }
+    };
+
+    std::vector<entry> tmp;
+
+public:
+    incidence_matrix() : sp_count(0), col_off(1, 0) {}
+
+    uint64_t species_count() const {  return sp_count;  }
+    uint64_t reaction_count() const {  return col_off.size()-1;  }
+    uint64_t entry_count() const {  return row.size();  }
+
+
+    /*
+     * Network sink interface
+     */
+
+    void reserve(size_t, size_t re_count) {
+        col_off.reserve(col_off.size()+re_count);
+    }
+
+    void add_species(const std::string&, bool, double) {
+        ++sp_count;
+    }
+
+    void add_reaction(bool, double, double, double, double,
+                      const std::pair<size_t, size_t>* educts, size_t n_educts,
+                      const std::pair<size_t, size_t>* products, size_t n_products) {
+        tmp.clear();
+        for(size_t i=0; i<n_educts; ++i)
+            tmp.push_back(entry{educts[i].first, int64_t(educts[i].second), 0});
+        for(size_t i=0; i<n_products; ++i)
+            tmp.push_back(entry{products[i].first, 0, int64_t(products[i].second)});
+        std::sort(tmp.begin(), tmp.end());
+
+        // merge entries of the same species
+        for(size_t i=0; i<tmp.size(); ++i) {
+            if(i != 0 && tmp[i].species == row.back()) {
+                col_educt.back() += tmp[i].educt;
+                col_product.back() += tmp[i].product;
+                continue;
+            }
+
+            row.push_back(tmp[i].species);
+            col_educt.push_back(tmp[i].educt);
+            col_product.push_back(tmp[i].product);
+        }
+
+        col_off.push_back(row.size());
+    }
+
+
+    /*
+     * Builds the rows (CSR) from the columns (counting sort, so the
+     * columns of every row are ascending).
+     */
+
+    void finish() {
+        uint64_t n=row.size();
+        row_off.assign(sp_count+1, 0);
+        for(uint64_t i=0; i<n; ++i)
+            ++row_off[row[i]+1];
+        for(uint64_t s=0; s<sp_count; ++s)
+            row_off[s+1] += row_off[s];
+
+        std::vector<uint64_t> next(row_off.begin(), row_off.end()-1);
+        col.resize(n);
+        row_educt.resize(n);
+        row_product.resize(n);
+        for(uint64_t r=0; r+1<col_off.size(); ++r)
+            for(uint64_t i=col_off[r]; i<col_off[r+1]; ++i) {
+                uint64_t p=next[row[i]]++;
+                col[p]=r;
+                row_educt[p]=col_educt[i];
+                row_product[p]=col_product[i];
+            }
+    }
+};
+
+
+/*
+ * Writes the incidence matrix `m` (after finish()) as binary file
+ * `filename` (gzip compressed if the name ends with ".gz"). Returns 0 on
+ * success.
+ */
+
+inline int write_incidence(const std::string& filename, const incidence_matrix& m) {
+    output_file out;
+    if(!out.open(filename, io_threads()))
+        return 1;
+
+    uint64_t header[8]={0, m.species_count(), m.reaction_count(), m.entry_count(), 0, 0, 0, 0};
+    std::memcpy(header, "JRNFI001", 8);
+    jrnfb_write_array(out, header, 8);
+
+    jrnfb_write_array(out, m.col_off.data(), m.col_off.size());
+    jrnfb_write_array(out, m.row.data(), m.row.size());
+    jrnfb_write_array(out, m.col_educt.data(), m.col_educt.size());
+    jrnfb_write_array(out, m.col_product.data(), m.col_product.size());
+
+    jrnfb_write_array(out, m.row_off.data(), m.row_off.size());
+    jrnfb_write_array(out, m.col.data(), m.col.size());
+    jrnfb_write_array(out, m.row_educt.data(), m.row_educt.size());
+    jrnfb_write_array(out, m.row_product.data(), m.row_product.size());
+
+    return out.close() ? 0 : 1;
+}
+
+
+/*
+ * Writes the stoichiometric matrix of `m` (species x reactions, product -
+ * educt multiplicity) as Matrix Market file `filename`. Returns 0 on
+ * success.
+ */
+
+inline int write_matrix_market(const std::string& filename, const incidence_matrix& m) {
+    output_file out;
+    if(!out.open(filename, io_threads()))
+        return 1;
+
+    std::string b="%%MatrixMarket matrix coordinate integer general\n"
+                  "% stoichiometric matrix: rows species, columns reactions (product - educt)\n";
+    b += std::to_string(m.species_count()) + " " + std::to_string(m.reaction_count()) + " "
+       + std::to_string(m.entry_count()) + "\n";
+
+    for(uint64_t r=0; r<m.reaction_count(); ++r) {
+        for(uint64_t i=m.col_off[r]; i<m.col_off[r+1]; ++i) {
+            b += std::to_string(m.row[i]+1);
+            b.push_back(' ');
+            b += std::to_string(r+1);
+            b.push_back(' ');
+            b += std::to_string(m.col_product[i]-m.col_educt[i]);
+            b.push_back('\n');
+        }
+
+        if(b.size() >= (size_t(1) << 20)) {
+            out.write(b);
+            b.clear();
+        }
+    }
+
+    out.write(b);
+    return out.close() ? 0 : 1;
+}
+
+
+/*
+ * Writes the incidence matrix of the network `st` (rn_store or any type
+ * with emit()) to the binary file `bin` and / or the Matrix Market file
+ * `mtx` (empty names are skipped). Returns 0 on success.
+ */
+
+template<typename network_t>
+int write_incidence(const std::string& bin, const std::string& mtx, const network_t& st) {
+    incidence_matrix m;
+    st.emit(m);
+    m.finish();
+
+    if(!bin.empty() && write_incidence(bin, m))
+        return 1;
+
+    return (!mtx.empty() && write_matrix_market(mtx, m)) ? 1 : 0;
+}
+
+
+#endif
@@ -0,0 +1,358 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Binary variant of the jrnf format ("jrnfb"). All data is stored in flat
+ * arrays (structure of arrays, little endian, 8 byte aligned) whose
+ * positions follow from the counts in the header:
+ *   header (64 bytes): "JRNFB001", #species, #reactions, #stoichiometric
+ *                      entries, size of name block (all uint64)
+ *   species:   energy (double), constant (uint8), name offsets
+ *              (uint64, #species+1), names (chars, not terminated)
+ *   reactions: reversible (uint8), c, k, k_b, activation (double),
+ *              stoichiometry offsets (uint64, #reactions+1), #educts
+ *              (uint64), species ids and multiplicities (uint64 each,
+ *              educts of a reaction before its products)
+ * The offset arrays make it possible to access single species and
+ * reactions without parsing the whole file (see jrnfb_file). Offsets and
+ * species ids are checked once when the file is opened.
+ */
+
+#ifndef __JRNF_TOOLS_JRNF_BINARY_H__
+#define __JRNF_TOOLS_JRNF_BINARY_H__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+
+#include "net_tools/reaction_network.h"
+#include "jrnf_mmap.h"
+#include "compressed_file.h"
+#include "network_sink.h"
+#include "reaction_store.h"
+
+static_assert(std::endian::native == std::endian::little, "jrnfb I/O assumes a little endian host");
+static_assert(sizeof(size_t) == 8, "jrnfb I/O assumes 64 bit size_t");
+
+
+/*
+ * Positions of all arrays in a jrnfb-file, computed from the header counts.
+ */
+
+struct jrnfb_layout {
+    uint64_t sp_count, re_count, st_count, names_size;
+    uint64_t energy, constant, name_off, names;
+    uint64_t reversible, c, k, k_b, activation, st_off, n_educts, st_id, st_mul;
+    uint64_t total;
+
+    static uint64_t pad8(uint64_t s) {  return (s+7) & ~uint64_t(7);  }
+
+    jrnfb_layout(uint64_t sp, uint64_t re, uint64_t st, uint64_t ns)
+        : sp_count(sp), re_count(re), st_count(st), names_size(ns) {
+        energy=64;
+        constant=energy+8*sp;
+        name_off=constant+pad8(sp);
+        names=name_off+8*(sp+1);
+        reversible=names+pad8(ns);
+        c=reversible+pad8(re);
+        k=c+8*re;
+        k_b=k+8*re;
+        activation=k_b+8*re;
+        st_off=activation+8*re;
+        n_educts=st_off+8*(re+1);
+        st_id=n_educts+8*re;
+        st_mul=st_id+8*st;
+        total=st_mul+8*st;
+    }
+};
+
+
+/*
+ * Writes the network `st` to the jrnfb-file `filename`. Returns false if 
+ * writing failed.
+ */
+
+template<typename T>
+void jrnfb_write_array(output_file& out, const T* data, size_t n) {
+    out.write((const char*)data, n*sizeof(T));
+}
+
+inline void jrnfb_write_padding(output_file& out, size_t n) {
+    static const char zeros[8]={0, 0, 0, 0, 0, 0, 0, 0};
+    out.write(zeros, jrnfb_layout::pad8(n)-n);
+}
+
+inline bool write_jrnfb(const std::string& filename, const rn_store& st) {
+    output_file out;
+    if(!out.open(filename, io_threads()))
+        return false;
+
+    uint64_t header[8]={0, st.species_count(), st.reaction_count(), st.stoich.size(), st.names.size(), 0, 0, 0};
+    std::memcpy(header, "JRNFB001", 8);
+    jrnfb_write_array(out, header, 8);
+
+    jrnfb_write_array(out, st.energy.data(), st.energy.size());
+    jrnfb_write_array(out, st.constant.data(), st.constant.size());
+    jrnfb_write_padding(out, st.constant.size());
+    jrnfb_write_array(out, st.name_off.data(), st.name_off.size());
+    jrnfb_write_array(out, st.names.data(), st.names.size());
+    jrnfb_write_padding(out, st.names.size());
+
+    jrnfb_write_array(out, st.reversible.data(), st.reversible.size());
+    jrnfb_write_padding(out, st.reversible.size());
+    jrnfb_write_array(out, st.c.data(), st.c.size());
+    jrnfb_write_array(out, st.k.data(), st.k.size());
+    jrnfb_write_array(out, st.k_b.data(), st.k_b.size());
+    jrnfb_write_array(out, st.activation.data(), st.activation.size());
+    jrnfb_write_array(out, st.st_off.data(), st.st_off.size());
+    jrnfb_write_array(out, st.n_educts.data(), st.n_educts.size());
+
+    // stoichiometry is stored as (id, mul) pairs, the file has separate arrays
+    std::vector<uint64_t> buf;
+    for(size_t m=0; m<2; ++m) 
+        for(size_t b=0; b<st.stoich.size(); b += 65536) {
+            size_t e=std::min(st.stoich.size(), b+65536);
+            buf.resize(e-b);
+            for(size_t j=b; j<e; ++j)
+                buf[j-b]=(m == 0) ? st.stoich[j].first : st.stoich[j].second;
+            jrnfb_write_array(out, buf.data(), buf.size());
+        }
+
+    return out.close();
+}
+
+
+/*
+ * Network sink writing a jrnfb-file. Because the arrays are stored one
+ * after the other the network is collected in a rn_store and written by
+ * close().
+ */
+
+class jrnfb_writer : public rn_store {
+    std::string filename;
+    bool is_open;
+
+public:
+    jrnfb_writer() : is_open(false) {}
+    ~jrnfb_writer() {  close();  }
+
+    bool open(const std::string& fn) {
+        filename=fn;
+        clear();
+        std::ofstream test(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        is_open=test.is_open();
+        return is_open;
+    }
+
+    bool close() {
+        if(!is_open)
+            return true;
+
+        is_open=false;
+        return write_jrnfb(filename, *this);
+    }
+};
+
+
+inline bool is_jrnfb_data(const char* b, const char* e) {
+    return e-b >= 64 && std::memcmp(b, "JRNFB001", 8) == 0;
+}
+
+
+/*
+ * Memory mapped jrnfb-file giving random access to single species and
+ * reactions.
+ */
+
+class jrnfb_file {
+    input_file f;
+    jrnfb_layout l;
+
+    template<typename T>
+    T get(uint64_t section, size_t i) const {
+        T v;
+        std::memcpy(&v, f.begin()+section+i*sizeof(T), sizeof(T));
+        return v;
+    }
+
+    // Checks that offsets [0, n] of `section` start at 0, don't decrease
+    // and end at `last`
+    bool check_offsets(uint64_t section, uint64_t n, uint64_t last) const {
+        uint64_t prev=0;
+        if(get<uint64_t>(section, 0) != 0)
+            return false;
+
+        for(uint64_t i=1; i<=n; ++i) {
+            uint64_t o=get<uint64_t>(section, i);
+            if(o < prev)
+                return false;
+            prev=o;
+        }
+
+        return prev == last;
+    }
+
+    // Checks the whole file, so species and reactions can be accessed
+    // without further checks (as the text parser does)
+    bool check() const {
+        // every element takes at least one byte, so the layout can't overflow
+        uint64_t max=f.size();
+        if(l.sp_count > max || l.re_count > max || l.st_count > max || l.names_size > max)
+            return false;
+
+        jrnfb_layout c(l.sp_count, l.re_count, l.st_count, l.names_size);
+        if(f.size() < c.total)
+            return false;
+
+        if(!check_offsets(c.name_off, c.sp_count, c.names_size) ||
+           !check_offsets(c.st_off, c.re_count, c.st_count))
+            return false;
+
+        for(uint64_t i=0; i<c.re_count; ++i)
+            if(get<uint64_t>(c.n_educts, i) > get<uint64_t>(c.st_off, i+1)-get<uint64_t>(c.st_off, i))
+                return false;
+
+        for(uint64_t j=0; j<c.st_count; ++j)
+            if(get<uint64_t>(c.st_id, j) >= c.sp_count)
+                return false;
+
+        return true;
+    }
+
+public:
+    jrnfb_file() : l(0, 0, 0, 0) {}
+
+
+    /*
+     * Opens and checks the file (sizes, offsets, species ids). Returns 0 on
+     * success, 1 if the file can't be opened / is broken and 2 if it is no
+     * jrnfb-file.
+     */
+
+    int open(const std::string& filename) {
+        input_file in;
+        if(!in.open(filename, false))
+            return 1;
+
+        return open(in);
+    }
+
+
+    /*
+     * As open(filename) for the already opened file `in`. If it is a jrnfb-
+     * file its content is taken over (and `in` is closed), otherwise `in`
+     * isn't changed.
+     */
+
+    int open(input_file& in) {
+        l=jrnfb_layout(0, 0, 0, 0);
+        f.close();
+        if(!is_jrnfb_data(in.begin(), in.end()))
+            return 2;
+
+        if(!f.take(in))
+            return 1;
+
+        l.sp_count=get<uint64_t>(0, 1);
+        l.re_count=get<uint64_t>(0, 2);
+        l.st_count=get<uint64_t>(0, 3);
+        l.names_size=get<uint64_t>(0, 4);
+        if(!check()) {
+            l=jrnfb_layout(0, 0, 0, 0);
+            return 1;
+        }
+
+        l=jrnfb_layout(l.sp_count, l.re_count, l.st_count, l.names_size);
+        return 0;
+    }
+
+    size_t species_count() const {  return l.sp_count;  }
+    size_t reaction_count() const {  return l.re_count;  }
+
+    std::string species_name(size_t i) const {
+        uint64_t b=get<uint64_t>(l.name_off, i), e=get<uint64_t>(l.name_off, i+1);
+        return std::string(f.begin()+l.names+b, f.begin()+l.names+e);
+    }
+
+    bool species_constant(size_t i) const {  return get<uint8_t>(l.constant, i) != 0;  }
+    double species_energy(size_t i) const {  return get<double>(l.energy, i);  }
+
+
+    /*
+     * Adds species `i` / reaction `i` to the network sink `s`.
+     */
+
+    template<typename sink_t>
+    void emit_species(sink_t& s, size_t i) const {
+        s.add_species(species_name(i), species_constant(i), species_energy(i));
+    }
+
+    template<typename sink_t>
+    void emit_reaction(sink_t& s, size_t i, std::vector< std::pair<size_t, size_t> >& buf) const {
+        uint64_t b=get<uint64_t>(l.st_off, i), e=get<uint64_t>(l.st_off, i+1);
+        uint64_t n_ed=get<uint64_t>(l.n_educts, i);
+
+        buf.resize(e-b);
+        for(uint64_t j=b; j<e; ++j)
+            buf[j-b]=std::make_pair(size_t(get<uint64_t>(l.st_id, j)), size_t(get<uint64_t>(l.st_mul, j)));
+
+        s.add_reaction(get<uint8_t>(l.reversible, i) != 0, get<double>(l.c, i),
+                       get<double>(l.k, i), get<double>(l.k_b, i), get<double>(l.activation, i),
+                       buf.data(), n_ed, buf.data()+n_ed, e-b-n_ed);
+    }
+
+
+    /*
+     * Returns reaction `i` as reaction object.
+     */
+
+    reaction get_reaction(size_t i) const {
+        std::vector<species> sp;
+        std::vector<reaction> re;
+        std::vector< std::pair<size_t, size_t> > buf;
+        rn_vector_sink s(sp, re);
+        emit_reaction(s, i, buf);
+        return re.back();
+    }
+
+
+    /*
+     * Adds the whole network to the sink `s`.
+     */
+
+    template<typename sink_t>
+    void emit_all(sink_t& s) const {
+        s.reserve(l.sp_count, l.re_count);
+
+        for(size_t i=0; i<l.sp_count; ++i)
+            emit_species(s, i);
+
+        std::vector< std::pair<size_t, size_t> > buf;
+        for(size_t i=0; i<l.re_count; ++i)
+            emit_reaction(s, i, buf);
+    }
+};
+
+
+/*
+ * Reads the jrnfb-file `filename` into the network sink `s`. Return values
+ * as for jrnfb_file::open.
+ */
+
+template<typename sink_t>
+int read_jrnfb(const std::string& filename, sink_t& s) {
+    jrnfb_file f;
+    int r=f.open(filename);
+
+    if(r == 0)
+        f.emit_all(s);
+
+    return r;
+}
+
+
+#endif
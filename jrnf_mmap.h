@@ -0,0 +1,574 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Fast reader for jrnf-files (format see jrnf_stream.h). The file is mapped
+ * into memory and scanned by hand written number and token parsers (no
+ * iostreams, no locale). Species and reactions are given to a network sink
+ * (see network_sink.h) that is told the counts from the header in advance.
+ *
+ * The reactions of large files are parsed in parallel: the reaction
+ * section is split at line boundaries into shards, which are parsed on a
+ * thread pool into one rn_store each and then given to the sink in order.
+ * This needs one reaction per line (as written by all jrnf writers); for
+ * other files the reactions are parsed sequentially.
+ *
+ * Gzip compressed files are decompressed piece by piece while they are
+ * parsed (the reactions of every piece in parallel), so only a part of
+ * the uncompressed file is held in memory.
+ */
+
+#ifndef __JRNF_TOOLS_JRNF_MMAP_H__
+#define __JRNF_TOOLS_JRNF_MMAP_H__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "net_tools/reaction_network.h"
+#include "net_tools/reaction_network_fileop.h"
+#include "network_sink.h"
+#include "reaction_store.h"
+#include "thread_pool.h"
+#include "compressed_file.h"
+
+
+/*
+ * Read only memory mapping of a whole file.
+ */
+
+class mapped_file {
+    const char* ptr;
+    size_t len;
+
+    mapped_file(const mapped_file&);
+    mapped_file& operator=(const mapped_file&);
+
+public:
+    mapped_file() : ptr(0), len(0) {}
+    ~mapped_file() {  close();  }
+
+    bool open(const std::string& filename) {
+        close();
+
+        int fd=::open(filename.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        struct stat st;
+        if(fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        len=st.st_size;
+        if(len != 0) {
+            void* m=mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(m == MAP_FAILED) {
+                ::close(fd);
+                len=0;
+                return false;
+            }
+            ptr=(const char*)m;
+            madvise(m, len, MADV_SEQUENTIAL);
+        }
+
+        ::close(fd);
+        return true;
+    }
+
+    void close() {
+        if(ptr != 0)
+            munmap((void*)ptr, len);
+        ptr=0;
+        len=0;
+    }
+
+    const char* begin() const {  return ptr;  }
+    const char* end() const {  return ptr+len;  }
+    size_t size() const {  return len;  }
+
+    void swap(mapped_file& o) {
+        std::swap(ptr, o.ptr);
+        std::swap(len, o.len);
+    }
+};
+
+
+/*
+ * Content of an input file: memory mapped or, if it is gzip compressed,
+ * decompressed into memory (see compressed_file.h). Compressed files are
+ * decompressed as a whole or, opened with `whole`=false, in pieces of 64
+ * MB: [begin(), end()) then holds the current part and more() continues.
+ */
+
+class input_file {
+    mapped_file f;
+    std::string data;
+    gunzip_stream z;
+    bool gz;
+
+    static const size_t piece=size_t(1) << 26;
+
+    input_file(const input_file&);
+    input_file& operator=(const input_file&);
+
+public:
+    input_file() : gz(false) {}
+
+    bool open(const std::string& filename, bool whole=true) {
+        close();
+        if(!f.open(filename))
+            return false;
+
+        if(!is_gz_data(f.begin(), f.end()))
+            return true;
+
+        gz=true;
+        if(!z.open(f.begin(), f.end()) || !z.read(data, piece))
+            return false;
+
+        return whole ? read_all() : true;
+    }
+
+    void close() {
+        z.close();
+        f.close();
+        std::string().swap(data);
+        gz=false;
+    }
+
+    const char* begin() const {  return gz ? data.data() : f.begin();  }
+    const char* end() const {  return begin()+size();  }
+    size_t size() const {  return gz ? data.size() : f.size();  }
+
+    // [begin(), end()) is the rest of the file
+    bool complete() const {  return !gz || z.finished();  }
+
+    // End of the last whole line of the current part
+    const char* lines_end() const {
+        if(complete())
+            return end();
+
+        const char* p=(const char*)memrchr(begin(), '\n', size());
+        return p == 0 ? begin() : p+1;
+    }
+
+
+    /*
+     * Drops the content before `keep` and decompresses the next piece.
+     * Returns the new position of `keep` or 0 at the end of the file and
+     * if it is broken.
+     */
+
+    const char* more(const char* keep) {
+        if(complete())
+            return 0;
+
+        data.erase(0, keep-data.data());
+        if(!z.read(data, piece))
+            return 0;
+
+        if(z.finished())
+            f.close();
+        return data.data();
+    }
+
+
+    /*
+     * Decompresses the rest of the file. Returns false if it is broken.
+     */
+
+    bool read_all() {
+        while(!complete())
+            if(!z.read(data, std::max(data.size(), piece)))
+                return false;
+
+        if(gz)
+            f.close();
+        return true;
+    }
+
+
+    /*
+     * Takes the content of `o` (completely read, see read_all).
+     */
+
+    bool take(input_file& o) {
+        if(!o.read_all())
+            return false;
+
+        close();
+        f.swap(o.f);
+        data.swap(o.data);
+        gz=o.gz;
+        o.close();
+        return true;
+    }
+};
+
+
+/*
+ * Scanner for whitespace separated tokens and numbers on a character range.
+ * All get_* methods return false if there is no (valid) token left.
+ */
+
+class jrnf_scanner {
+    const char* p;
+    const char* e;
+
+    void skip_ws() {
+        while(p != e && (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r'))
+            ++p;
+    }
+
+public:
+    jrnf_scanner(const char* begin, const char* end) : p(begin), e(end) {}
+
+    bool get_token(const char*& tb, const char*& te) {
+        skip_ws();
+        tb=p;
+        while(p != e && *p != ' ' && *p != '\n' && *p != '\t' && *p != '\r')
+            ++p;
+        te=p;
+        return tb != te;
+    }
+
+    bool get_size(size_t& v) {
+        skip_ws();
+        if(p == e || *p < '0' || *p > '9')
+            return false;
+
+        v=0;
+        while(p != e && *p >= '0' && *p <= '9') {
+            size_t d=size_t(*(p++)-'0');
+            if(v > (~size_t(0)-d)/10)       // doesn't fit
+                return false;
+            v=10*v+d;
+        }
+        return true;
+    }
+
+    bool get_bool(bool& v) {
+        size_t i;
+        if(!get_size(i))
+            return false;
+        v=(i != 0);
+        return true;
+    }
+
+    bool get_double(double& v) {
+        skip_ws();
+        if(p != e && *p == '+')
+            ++p;
+
+        std::from_chars_result r=std::from_chars(p, e, v);
+        if(r.ec != std::errc())
+            return false;
+        p=r.ptr;
+        return true;
+    }
+
+    const char* pos() const {  return p;  }
+    size_t left() const {  return e-p;  }
+
+    bool at_end() {
+        skip_ws();
+        return p == e;
+    }
+};
+
+
+/*
+ * Parses one reaction (network with `sp_c` species) from `sc` into `s`,
+ * `stoich` is used as buffer. Returns false if the content is broken.
+ */
+
+template<typename sink_t>
+bool parse_jrnf_reaction(jrnf_scanner& sc, size_t sp_c, std::vector< std::pair<size_t, size_t> >& stoich, sink_t& s) {
+    bool reversible;
+    double c, k, k_b, activation;
+    size_t ed_c, pr_c;
+
+    if(!sc.get_bool(reversible) || !sc.get_double(c) || !sc.get_double(k) ||
+       !sc.get_double(k_b) || !sc.get_double(activation) ||
+       !sc.get_size(ed_c) || !sc.get_size(pr_c))
+        return false;
+
+    // every educt / product takes at least 4 characters
+    if(ed_c > sc.left()/4 || pr_c > sc.left()/4)
+        return false;
+
+    stoich.resize(ed_c+pr_c);
+    for(size_t j=0; j<ed_c+pr_c; ++j)
+        if(!sc.get_size(stoich[j].first) || !sc.get_size(stoich[j].second) ||
+           stoich[j].first >= sp_c)
+            return false;
+
+    s.add_reaction(reversible, c, k, k_b, activation,
+                   stoich.data(), ed_c, stoich.data()+ed_c, pr_c);
+    return true;
+}
+
+
+/*
+ * Gives the reactions of `part` to the sink `s` (copied column wise if the
+ * sink is a rn_store).
+ */
+
+template<typename sink_t>
+void emit_reactions(sink_t& s, const rn_store& part) {
+    for(size_t j=0; j<part.reaction_count(); ++j)
+        part.emit_reaction(s, j);
+}
+
+inline void emit_reactions(rn_store& s, const rn_store& part) {
+    s.append_reactions(part);
+}
+
+
+/*
+ * Parses the reactions [b, e) (whole lines, between `min_c` and `max_c`
+ * reactions of a network with `sp_c` species) in shards split at line
+ * boundaries on `threads` threads and gives them in order to `s`. Returns
+ * the number of reactions, 0 (and doesn't touch `s`) if a shard can't be
+ * parsed on its own or the number is out of range, the caller then parses
+ * sequentially.
+ */
+
+template<typename sink_t>
+size_t parse_jrnf_reactions_sharded(const char* b, const char* e, size_t sp_c, size_t min_c, size_t max_c,
+                                    sink_t& s, size_t threads) {
+    const size_t min_shard=1 << 20;
+    size_t shards=std::min(4*threads, size_t(e-b)/min_shard+1);
+
+    std::vector<const char*> bounds(1, b);
+    for(size_t i=1; i<shards; ++i) {
+        const char* p=std::max(bounds.back(), b+(e-b)/shards*i);
+        p=(const char*)memchr(p, '\n', e-p);
+        if(p == 0)
+            break;
+        bounds.push_back(p+1);
+    }
+    bounds.push_back(e);
+
+    std::vector<rn_store> parts(bounds.size()-1);
+    std::vector<uint8_t> ok(parts.size(), 0);
+    parallel_for(parts.size(), threads, [&](size_t i) {
+        jrnf_scanner sc(bounds[i], bounds[i+1]);
+        std::vector< std::pair<size_t, size_t> > stoich;
+        while(!sc.at_end())
+            if(!parse_jrnf_reaction(sc, sp_c, stoich, parts[i]))
+                return;
+        ok[i]=1;
+    });
+
+    size_t count=0;
+    for(size_t i=0; i<parts.size(); ++i) {
+        if(!ok[i])
+            return 0;
+        count += parts[i].reaction_count();
+    }
+
+    if(count < min_c || count > max_c)
+        return 0;
+
+    for(size_t i=0; i<parts.size(); ++i) {
+        emit_reactions(s, parts[i]);
+        parts[i].clear();
+    }
+
+    return count;
+}
+
+
+/*
+ * Parses one species from `sc` into `s`, `name` is used as buffer. Returns
+ * false if the content is broken.
+ */
+
+template<typename sink_t>
+bool parse_jrnf_species(jrnf_scanner& sc, std::string& name, sink_t& s) {
+    bool constant;
+    double energy;
+    const char *tb, *te;
+
+    if(!sc.get_bool(constant) || !sc.get_token(tb, te) || !sc.get_double(energy))
+        return false;
+
+    name.assign(tb, te);
+    s.add_species(name, constant, energy);
+    return true;
+}
+
+
+/*
+ * Parses the jrnf-file content [b, e) into the network sink `s`, reactions
+ * of large files on `threads` threads (0 - all cores). Returns 0 on 
+ * success, 1 if the content is broken and 2 if it isn't a jrnf0003 file.
+ */
+
+template<typename sink_t>
+int parse_jrnf(const char* b, const char* e, sink_t& s, size_t threads=1) {
+    jrnf_scanner sc(b, e);
+    const char *tb, *te;
+
+    if(!sc.get_token(tb, te) || std::string(tb, te) != "jrnf0003")
+        return 2;
+
+    size_t sp_c, re_c;
+    if(!sc.get_size(sp_c) || !sc.get_size(re_c))
+        return 1;
+
+    // every species / reaction needs at least a line, so the counts of
+    // broken headers don't reserve more than the file size
+    s.reserve(std::min(sp_c, size_t(e-b)), std::min(re_c, size_t(e-b)));
+
+    std::string name;
+    for(size_t i=0; i<sp_c; ++i)
+        if(!parse_jrnf_species(sc, name, s))
+            return 1;
+
+    threads=thread_count(threads);
+    if(threads > 1 && size_t(e-sc.pos()) > 4*(1 << 20) && re_c != 0 &&
+       parse_jrnf_reactions_sharded(sc.pos(), e, sp_c, re_c, re_c, s, threads) == re_c)
+        return 0;
+
+    std::vector< std::pair<size_t, size_t> > stoich;
+    for(size_t i=0; i<re_c; ++i)
+        if(!parse_jrnf_reaction(sc, sp_c, stoich, s))
+            return 1;
+
+    return 0;
+}
+
+
+/*
+ * Parses `n` records of the input `f` starting at `p` with `parse` (called
+ * with a scanner, returns false if the record is broken). The scanner
+ * only sees whole lines; if a record can't be parsed, the next piece of
+ * a compressed file is decompressed and the record is parsed again. `p`
+ * is moved behind the last record (and the following whitespace).
+ * Returns false if a record is broken.
+ */
+
+template<typename parse_t>
+bool parse_jrnf_records(input_file& f, const char*& p, size_t n, parse_t parse) {
+    for(size_t i=0; i<n; ) {
+        jrnf_scanner sc(p, f.lines_end());
+        const char* rec=p;
+        while(i < n && (rec=sc.pos(), parse(sc)))
+            ++i;
+
+        if(i == n) {
+            sc.at_end();        // skips the whitespace
+            p=sc.pos();
+            break;
+        }
+
+        if((p=f.more(rec)) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+
+/*
+ * Parses the jrnf-file `f` into the network sink `s` as parse_jrnf does.
+ * Compressed files opened in pieces (see input_file) are decompressed
+ * while they are parsed, the reactions of every piece on `threads`
+ * threads.
+ */
+
+template<typename sink_t>
+int parse_jrnf(input_file& f, sink_t& s, size_t threads=1) {
+    if(f.complete())
+        return parse_jrnf(f.begin(), f.end(), s, threads);
+
+    // the first piece holds the header (or the file is complete)
+    jrnf_scanner sc(f.begin(), f.lines_end());
+    const char *tb, *te;
+    if(!sc.get_token(tb, te) || std::string(tb, te) != "jrnf0003")
+        return 2;
+
+    size_t sp_c, re_c;
+    if(!sc.get_size(sp_c) || !sc.get_size(re_c))
+        return 1;
+
+    // bounded by the size of the first piece as for broken headers
+    s.reserve(std::min(sp_c, f.size()), std::min(re_c, f.size()));
+
+    const char* p=sc.pos();
+    std::string name;
+    if(!parse_jrnf_records(f, p, sp_c, [&](jrnf_scanner& r) {  return parse_jrnf_species(r, name, s);  }))
+        return 1;
+
+    threads=thread_count(threads);
+    std::vector< std::pair<size_t, size_t> > stoich;
+    for(size_t done=0; done < re_c; ) {
+        const char* e=f.lines_end();
+        size_t k=0;
+        if(threads > 1 && size_t(e-p) > 4*(1 << 20))
+            k=parse_jrnf_reactions_sharded(p, e, sp_c, 1, re_c-done, s, threads);
+
+        if(k != 0) {
+            done += k;
+            p=e;
+        } else
+            // sequentially up to the end of the piece
+            do {
+                if(!parse_jrnf_records(f, p, 1, [&](jrnf_scanner& r) {  return parse_jrnf_reaction(r, sp_c, stoich, s);  }))
+                    return 1;
+            } while(++done < re_c && p != f.lines_end());
+
+        if(done < re_c && (p=f.more(p)) == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+
+/*
+ * Reads the jrnf-file `filename` into the network sink `s` (reactions on
+ * io_threads() threads). Return values as for parse_jrnf (1 also if the
+ * file can't be opened).
+ */
+
+template<typename sink_t>
+int read_jrnf_mmap(const std::string& filename, sink_t& s) {
+    input_file f;
+    if(!f.open(filename, false))
+        return 1;
+
+    return parse_jrnf(f, s, io_threads());
+}
+
+
+/*
+ * Replacement for read_jrnf_reaction_n, filling the vectors `sp` and `re`.
+ * Files of other jrnf versions are given to read_jrnf_reaction_n. Returns
+ * 0 on success.
+ */
+
+inline int read_jrnf_mmap(const std::string& filename, std::vector<species>& sp, std::vector<reaction>& re) {
+    rn_vector_sink s(sp, re);
+    int r=read_jrnf_mmap(filename, s);
+
+    if(r == 2)
+        return read_jrnf_reaction_n(filename, sp, re);
+
+    return r;
+}
+
+
+#endif
@@ -0,0 +1,211 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Streaming writer for jrnf-files. Species and reactions are written as
+ * they are added, so a network doesn't have to be held in memory as
+ * vectors of species and reaction objects before writing it.
+ *
+ * The file has the same layout as the one of write_jrnf_reaction_n:
+ *   jrnf0003
+ *   <#species> <#reactions>
+ *   <constant> <name> <energy>                         (once per species)
+ *   <reversible> <c> <k> <k_b> <activation> <#educts> <#products>
+ *       <educt id> <educt mul> ... <product id> <product mul> ...  (per reaction)
+ * If the counts are given up front (set_counts) the count line is written
+ * as by write_jrnf_reaction_n. Otherwise (streaming, the counts are only
+ * known after the last reaction) it is padded with spaces to a fixed
+ * width and rewritten by close().
+ * Lines are formatted with to_chars (see number_format.h) into a buffer
+ * that is written in blocks of a few MB. Files named "*.gz" are written
+ * gzip compressed (see compressed_file.h).
+ */
+
+#ifndef __JRNF_TOOLS_JRNF_STREAM_H__
+#define __JRNF_TOOLS_JRNF_STREAM_H__
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "net_tools/reaction_network.h"
+#include "number_format.h"
+#include "compressed_file.h"
+
+
+class jrnf_writer {
+    output_file out;
+    size_t count_pos;
+    size_t sp_count, re_count;
+    size_t sp_exact, re_exact;
+    bool exact, counts_written;
+    std::string buf;
+    int precision;
+
+    std::string count_line(size_t sp, size_t re, bool padded) const {
+        std::string line;
+        append_number(line, sp);
+        line.push_back(' ');
+        append_number(line, re);
+        if(padded)
+            line.resize(41, ' ');  // enough for two 20 digit numbers
+        line.push_back('\n');
+        return line;
+    }
+
+    void write_counts() {
+        if(counts_written)
+            return;
+
+        counts_written=true;
+        std::string line=count_line(sp_exact, re_exact, !exact);
+        if(exact)
+            out.write(line);
+        else
+            count_pos=out.write_fixed(line.data(), line.size());
+    }
+
+    void write_stoich(const std::pair<size_t, size_t>* s, size_t n) {
+        for(size_t i=0; i<n; ++i) {
+            buf.push_back(' ');
+            append_number(buf, s[i].first);
+            buf.push_back(' ');
+            append_number(buf, s[i].second);
+        }
+    }
+
+    void flush(size_t limit) {
+        if(buf.size() > limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+    }
+
+public:
+    jrnf_writer() : count_pos(0), sp_count(0), re_count(0), sp_exact(0), re_exact(0),
+                    exact(false), counts_written(false), precision(0) {}
+    ~jrnf_writer() { close(); }
+
+
+    /*
+     * Opens the file `filename` and writes the header. Returns false if
+     * the file could not be opened.
+     */
+
+    bool open(const std::string& filename) {
+        if(!out.open(filename, io_threads()))
+            return false;
+
+        sp_count=re_count=sp_exact=re_exact=0;
+        exact=counts_written=false;
+        precision=output_precision();
+        buf.clear();
+        buf.reserve(size_t(1) << 22);
+        out.write("jrnf0003\n");
+        return true;
+    }
+
+
+    /*
+     * Gives the exact numbers of species and reactions that will be added
+     * (before the first species), so the count line isn't padded. close()
+     * fails if other numbers are added.
+     */
+
+    void set_counts(size_t sp, size_t re) {
+        if(counts_written)
+            return;
+
+        exact=true;
+        sp_exact=sp;
+        re_exact=re;
+    }
+
+
+    void reserve(size_t, size_t) {}
+
+
+    /*
+     * Appends a species. All species have to be added before the first
+     * reaction. The id of a species is the number of species added before.
+     */
+
+    void add_species(const std::string& name, bool constant, double energy) {
+        write_counts();
+        buf.append(constant ? "1 " : "0 ");
+        buf.append(name);
+        buf.push_back(' ');
+        append_number(buf, energy, precision);
+        buf.push_back('\n');
+        flush(size_t(1) << 22);
+        ++sp_count;
+    }
+
+    void add_species(const species& s) {
+        add_species(s.get_name(), s.is_constant(), s.get_energy());
+    }
+
+
+    /*
+     * Appends a reaction. Educts and products are given as arrays of
+     * (species id, multiplicity) pairs.
+     */
+
+    void add_reaction(bool reversible, double c, double k, double k_b, double activation,
+                      const std::pair<size_t, size_t>* educts, size_t n_educts,
+                      const std::pair<size_t, size_t>* products, size_t n_products) {
+        write_counts();
+        buf.append(reversible ? "1 " : "0 ");
+        append_number(buf, c, precision);
+        buf.push_back(' ');
+        append_number(buf, k, precision);
+        buf.push_back(' ');
+        append_number(buf, k_b, precision);
+        buf.push_back(' ');
+        append_number(buf, activation, precision);
+        buf.push_back(' ');
+        append_number(buf, n_educts);
+        buf.push_back(' ');
+        append_number(buf, n_products);
+        write_stoich(educts, n_educts);
+        write_stoich(products, n_products);
+        buf.push_back('\n');
+        flush(size_t(1) << 22);
+        ++re_count;
+    }
+
+    void add_reaction(const reaction& r) {
+        const std::vector< std::pair<size_t, size_t> >& ed=r.get_educts();
+        const std::vector< std::pair<size_t, size_t> >& pr=r.get_products();
+        add_reaction(r.is_reversible(), r.get_c(), r.get_k(), r.get_k_b(), r.get_activation(),
+                     ed.data(), ed.size(), pr.data(), pr.size());
+    }
+
+
+    /*
+     * Writes the final species and reaction counts to the header (if not
+     * given by set_counts) and closes the file. Returns false if any write
+     * failed or other counts than given by set_counts were added.
+     */
+
+    bool close() {
+        if(!out.is_open())
+            return true;
+
+        write_counts();
+        flush(0);
+
+        bool counts_ok=!exact || (sp_count == sp_exact && re_count == re_exact);
+        if(!exact) {
+            std::string line=count_line(sp_count, re_count, true);
+            out.rewrite_fixed(count_pos, line.data(), line.size());
+        }
+
+        return out.close() && counts_ok;
+    }
+
+    size_t get_species_count() const {  return sp_count;  }
+    size_t get_reaction_count() const {  return re_count;  }
+};
+
+
+#endif
@@ -3,191 +3,85 @@
  * description: 
  * Programm with C++ Tools for generating different types of complex
  * networks / reaction networks and transforming between them.
- * 
- * TODO: Complex network generation of 2-2 networks should have virtual links 
- *       included in connectivity check
  */
 
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <atomic>
 #include <boost/concept_check.hpp>
 
 #include "net_tools/reaction_network.h"
 #include "net_tools/reaction_network_fileop.h"
 #include "net_tools/network_tools.h"
 #include "tools/cl_para.h"
+#include "network_io.h"
+#include "reaction_store.h"
+#include "sbml_writer.h"
+#include "number_format.h"
+#include "species_index.h"
+#include "network_transform.h"
+#include "create_modes.h"
+#include "thread_pool.h"
+#include "sweep.h"
+#include "pipeline.h"
+#include "profile.h"
+#include "network_stats.h"
+#include "incidence_matrix.h"
 using namespace std;
 
 
 /*
- *  Makro for diffusion connection of two species. (A -> B) reactions 
- * in both directions with all constants set to 1.0. 
- *  (The species 'a' and 'b' are connected by adding the respective
- *   reactions to the reaction vector re.)
+ * Collects the species to be removed by the transform_rm_species_* modes 
+ * ('sp' - comma separated names or patterns, 'sp_file' - file with names 
+ * or patterns) and marks them in `removed`. Returns false on errors and if
+ * a name matches no species.
  */
 
-void rm_diffusion(vector<reaction>& re, size_t a, size_t b) {
-    reaction rea_1;
-	reaction rea_2;
-	
-	rea_1.add_educt(a);
-	rea_1.add_product(b);
-	
-	rea_2.add_educt(b);
-	rea_2.add_product(a);
-	
-	rea_1.set_c(1.0);
-	rea_2.set_c(1.0);
-	rea_1.set_k(1.0);
-	rea_2.set_k(1.0);
-	rea_1.set_k_b(1.0);
-	rea_2.set_k_b(1.0);
-	
-	re.push_back(rea_1);
-	re.push_back(rea_2);
-}
-
-
-/*
- * Macro for adding a reaction in the form "A ---> B". 
- * ae - activation energy
- */
-
-void rm_1to1(vector<reaction>& re, size_t a, size_t b, double ae=0.0) {
-    reaction rea;
-    rea.set_activation(ae);
-    rea.set_reversible(false);
-    rea.add_educt(a);
-    rea.add_product(b);
-    
-    re.push_back(rea);  
-}
-
-
-/*
- * Macro for adding a reaction in the form "A <--> B". 
- * ae - activation energy
- */
-
-void rm_1to1rev(vector<reaction>& re, size_t a, size_t b, double ae=0.0) {
-    reaction rea;
-    rea.set_activation(ae);
-    rea.set_reversible(true);
-    rea.add_educt(a);
-    rea.add_product(b);
-    
-    re.push_back(rea);  
-}
-
-
-/*
- * Macro for adding a reaction in the form "A + B ---> C + D". 
- * ae - activation energy
- */
- 
-void rm_2to2(vector<reaction>& re, size_t a, size_t b, size_t c, size_t d, double ae=0.0) {
-    reaction rea;
-    rea.set_activation(ae);
-    rea.set_reversible(false);
-    rea.add_educt(a);
-    rea.add_educt(b);
-    rea.add_product(c);
-    rea.add_product(d);
-    
-    re.push_back(rea);  
-}
-
-
-/*
- * Macro for adding a reaction in the form "A + B <--> C + D". 
- * ae - activation energy
- * 
- * TODO unify if set_activation should get relative or absolute energy
- */
-
-void rm_2to2rev(vector<reaction>& re, size_t a, size_t b, size_t c, size_t d, size_t ae_dist=0) {
-    reaction rea;
-    rea.set_reversible(true);
-    rea.add_educt(a);
-    rea.add_educt(b);
-    rea.add_product(c);
-    rea.add_product(d);
-    
-    if(ae_dist == 0) {
-        rea.set_activation(double(rand())/RAND_MAX);
-    } else {
-        // WARNING Not implemented yet
-	rea.set_activation(double(rand())/RAND_MAX);
-    }
-    
-    re.push_back(rea);  
-}
-
+static bool mark_removed_species(cl_para& cl, const rn_store& st, std::vector<bool>& removed) {
+    std::vector<std::string> names;
+    if(!removed_species_names(cl, names))
+        return false;
 
-/*
- * Macro for adding a species to the vector `sp`.  Species is named 
- * "A_<t>", the energy distribution is set by energy_dist
- * 
- * TODO implement different energy distributions
- */
-
-void rm_add_species(std::vector<species>& sp, size_t t, size_t energy_dist) {
-    stringstream ss;
-    ss << "A_" << t;
-				
-    sp.push_back(species(sp.size(), ss.str(), false, 0));
-    if(energy_dist == 0) {
-        sp.back().set_energy(-double(rand())/RAND_MAX);
-    } else {
-        // WARNING Not implemented yet
-	    sp.back().set_energy(double(rand())/RAND_MAX);
-    }
+    return mark_removed_species(st, names, removed);
 }
 
 
 /*
- * Macro for adding a species to the vector `sp`.  Species is named 
- * "A_<t>", the energy is ignored.
+ * main
  */
 
-void rm_add_species_ne(std::vector<species>& sp, size_t t) {
-    stringstream ss;
-    ss << "A_" << t;
-	
-    sp.push_back(species(sp.size(), ss.str(), false, 0));  
-    sp.back().set_energy(0);
-}
-
-
-/*
- * Macro for adding a species to the vector `sp` without caring about
- * its energy. species gets name `name` and id is set accordingly.
- */
+int main(int argc, const char* argv[]) {
+    cl_para cl(argc, argv);  
 
-void rm_add_species_ne(std::vector<species>& sp, const std::string& name) {
-    sp.push_back(species(sp.size(), name, false, 0));
-    sp.back().set_energy(0);
-}
+    // Seed for all random numbers. The generators of net_tools use rand(),
+    // the macros of jrnf_tools the generator rn_rng (see create_modes.h).
+    uint64_t seed=cl.have_param("seed") ? strtoull(cl.get_param("seed").c_str(), 0, 10) : uint64_t(time(0));
 
+    // Significant digits of numbers in written jrnf / sbml files (0 - as
+    // many as needed to read back the same value, for sbml 6 as net_tools)
+    if(cl.have_param("precision"))
+        output_precision()=std::min(17, std::max(0, int(cl.get_param_i("precision"))));
 
+    // Threads for parsing the reactions of large jrnf files and compressing
+    // output files (all cores if not given)
+    if(cl.have_param("threads"))
+        io_threads()=cl.get_param_i("threads");
 
-/*
- * main
- */
-
-int main(int argc, const char* argv[]) {
-    srand(time(0));
-
-    cl_para cl(argc, argv);  
+    // Wall time, cpu time and peak memory of the phases of this run, written
+    // as JSON at the end ('profile' or 'profile=<file>', see profile.h)
+    std::string profile_file=cl.have_param("profile") ? cl.get_param("profile") : "";
+    profile_report report(cl.have_param("profile") ? profile_file.c_str() : 0, argc, argv);
 
    
     /*
      * Reads a jrnf-reaction network file and prints a textual
      * representation of the reactions. (The parameter 'in'
-     * specifies which file to read)
+     * specifies which file to read, if 'reaction' is given only
+     * the reaction with this index is printed)
      */   
    
     if(cl.have_param("print_network")){
@@ -200,11 +94,49 @@ int main(int argc, const char* argv[]) {
 	    std::vector<reaction> re;
       
     	std::string in=cl.get_param("in");
+        input_file f;
+        profile_phase ph("read");
+
+        // the file is opened once, its first bytes give the format
+        if(!f.open(in, false)) {
+	        cout << "Error at reading network file!" << std::endl;  
+	        return 1;
+        }
 		
-        if(read_jrnf_reaction_n(in, sp, re)) {
-	        cout << "Error at reading jrnf-file!" << std::endl;  
+        if(cl.have_param("reaction") && is_jrnfb_data(f.begin(), f.end())) {
+            // binary file: only the species and the one reaction are read
+            jrnfb_file bf;
+            if(bf.open(f)) {
+	            cout << "Error at reading network file!" << std::endl;  
+	            return 1;
+            }
+
+            size_t i=cl.get_param_i("reaction");
+            if(i >= bf.reaction_count()) {
+                cout << "Network has only " << bf.reaction_count() << " reactions!" << endl;
+                return 1;
+            }
+
+            rn_vector_sink s(sp, re);
+            for(size_t j=0; j<bf.species_count(); ++j)
+                bf.emit_species(s, j);
+
+            ph.next("print");
+            cout << bf.get_reaction(i).get_string(sp) << endl;
+        } else if(read_network(in, f, sp, re)) {
+	        cout << "Error at reading network file!" << std::endl;  
 	        return 1;
+        } else if(cl.have_param("reaction")) {
+            ph.next("print");
+            size_t i=cl.get_param_i("reaction");
+            if(i >= re.size()) {
+                cout << "Network has only " << re.size() << " reactions!" << endl;
+                return 1;
+            }
+
+            cout << re[i].get_string(sp) << endl;
 	    } else {
+	        ph.next("print");
 	        cout << "jrnf-File:" << endl;
 	        for(size_t i=0; i<re.size(); ++i) 
 	            cout << re[i].get_string(sp) << endl;
@@ -212,6 +144,114 @@ int main(int argc, const char* argv[]) {
     }
     
     
+    /*
+     * Converts a network file between jrnf and binary jrnfb format. 
+     * ('in' gives input and 'out' output file, the format of the
+     * output is jrnfb if the name of 'out' ends with ".jrnfb")
+     */
+    
+    if(cl.have_param("convert_format")) {
+        if(!cl.have_param("in") || !cl.have_param("out"))  {
+            cout << "You need to give parameters 'in' and 'out'! Could not proceed!" << endl;
+            return 1;  
+        }
+
+        cout << "Executing: convert_format!" << endl;
+        std::string in=cl.get_param("in");
+        std::string out=cl.get_param("out");
+        network_writer w;
+        profile_phase ph("convert");
+
+        if(!w.open(out)) {
+            cout << "Error at opening " << out << " for writing!" << endl;
+            return 1;
+        }
+
+        if(read_network(in, w)) {
+            cout << "Error at reading network file!" << std::endl;  
+            return 1;
+        }
+
+        if(!w.close()) {
+            cout << "Error at writing network file!" << endl;
+            return 1;
+        }
+    }
+    
+    
+    /*
+     * Computes statistics of the network in 'in' (degree distributions,
+     * reaction types, components, ...) while reading it and writes them
+     * as JSON to the file 'out' or to stdout.
+     */
+
+    if(cl.have_param("network_stats")) {
+        if(!cl.have_param("in"))  {
+            cout << "You need to give parameter 'in'! Could not proceed!" << endl;
+            return 1;
+        }
+
+        std::string in=cl.get_param("in");
+        network_stats st;
+        profile_phase ph("read");
+
+        if(read_network(in, st)) {
+            cout << "Error at reading network file!" << std::endl;
+            return 1;
+        }
+
+        ph.next("write");
+        if(!cl.have_param("out")) {
+            st.write_json(cout);
+        } else {
+            std::string out=cl.get_param("out");
+            std::ofstream o(out.c_str());
+            st.write_json(o);
+            if(!o.good()) {
+                cout << "Error at writing " << out << "!" << endl;
+                return 1;
+            }
+        }
+    }
+
+
+    /*
+     * Writes the species - reaction incidence matrix of the network in 'in'
+     * as binary CSC / CSR arrays to 'out' and / or as Matrix Market file to
+     * 'mtx' (see incidence_matrix.h)
+     */
+
+    if(cl.have_param("export_incidence")) {
+        if(!cl.have_param("in") || (!cl.have_param("out") && !cl.have_param("mtx")))  {
+            cout << "You need to give parameters 'in' and 'out' or 'mtx'! Could not proceed!" << endl;
+            return 1;
+        }
+
+        cout << "Executing: export_incidence!" << endl;
+        std::string in=cl.get_param("in");
+        std::string out=cl.have_param("out") ? cl.get_param("out") : "";
+        std::string mtx=cl.have_param("mtx") ? cl.get_param("mtx") : "";
+        incidence_matrix m;
+        profile_phase ph("read");
+
+        if(read_network(in, m)) {
+            cout << "Error at reading network file!" << std::endl;
+            return 1;
+        }
+
+        ph.next("build");
+        m.finish();
+        cout << "Incidence matrix of " << m.species_count() << " species, " << m.reaction_count()
+             << " reactions with " << m.entry_count() << " entries" << endl;
+
+        ph.next("write");
+        if((!out.empty() && write_incidence(out, m)) || (!mtx.empty() && write_matrix_market(mtx, m))) {
+            cout << "Error at writing incidence matrix!" << endl;
+            return 1;
+        }
+    }
+
+
     /*
      * Translates a jrnf file to a sbml file
      * ('in' gives input and 'out' output file)
@@ -226,78 +266,137 @@ int main(int argc, const char* argv[]) {
 	    cout << "Executing: translate_jrnf_sbml!" << endl;
 	    std::string in=cl.get_param("in");
 	    std::string out=cl.get_param("out");
-	    std::vector<species> sp;
-	    std::vector<reaction> re;
-	
-	    if(read_jrnf_reaction_n(in, sp, re)) {
-	        cout << "Error at reading jrnf-file!" << std::endl;  
-	        return 1;
+
+	    // streaming: sbml is written while reading, the network is not kept
+	    if(cl.have_param("stream")) {
+	        sbml_writer w;
+	        profile_phase ph("translate");
+	        if(!w.open(out)) {
+	            cout << "Error at opening sbml-file!" << std::endl;  
+	            return 1;
+	        }
+
+	        if(read_network(in, w)) {
+	            cout << "Error at reading network file!" << std::endl;  
+	            return 1;
+	        }
+
+	        if(!w.close()) {
+	            cout << "Error at writing sbml-file!" << std::endl;  
+	            return 1;
+	        }
+	    } else if(cl.have_param("sbml_format") && cl.get_param("sbml_format") == "net_tools") {
+	        // serial writer of net_tools (reference for the format)
+	        std::vector<species> sp;
+	        std::vector<reaction> re;
+	        profile_phase ph("read");
+	
+	        if(read_network(in, sp, re)) {
+	            cout << "Error at reading network file!" << std::endl;  
+	            return 1;
+	        }
+	
+	        cout << "Read file with " << sp.size() << " species and " << re.size() << " reactions!" << endl;
+	        ph.next("write");
+	        if(write_sbml_net_tools(out, sp, re)) {
+	            cout << "Error at writing sbml-file!" << std::endl;  
+	            return 1;
+	        }
+	    } else {
+	        size_t threads=cl.have_param("threads") ? cl.get_param_i("threads") : 0;
+	        rn_store st;
+	        profile_phase ph("read");
+	
+	        if(read_network(in, st)) {
+	            cout << "Error at reading network file!" << std::endl;  
+	            return 1;
+	        }
+	
+	        cout << "Read file with " << st.species_count() << " species and " << st.reaction_count() << " reactions!" << endl;
+	        ph.next("write");
+	        if(write_sbml(out, st, threads)) {
+	            cout << "Error at writing sbml-file!" << std::endl;  
+	            return 1;
+	        }
 	    }
-	
-	    cout << "Read file with " << sp.size() << " species and " << re.size() << " reactions!" << endl;
-	    write_sbml_reaction_n(out, sp, re);	
     }
     
     
     /*
      * Transforms an reaction network from the file 'in' to the
-     * file 'out' by removing all reactions with species 'sp'
+     * file 'out' by removing all reactions with the species 'sp' / 'sp_file'
      */
     
     if(cl.have_param("transform_rm_species_r")) {
-        if(!cl.have_param("in") || !cl.have_param("out") || !cl.have_param("sp"))  {
-	        cout << "You need to give parameters 'in', 'out' and 'sp'! Could not proceed!" << endl;
+        if(!cl.have_param("in") || !cl.have_param("out") || (!cl.have_param("sp") && !cl.have_param("sp_file")))  {
+	        cout << "You need to give parameters 'in', 'out' and 'sp' or 'sp_file'! Could not proceed!" << endl;
 	        return 1;  
 	    }      
       
       	cout << "Executing: transform_rm_species_r!" << endl;
-	    cout << " (removing a species and all reactions with it)" << endl;
+	    cout << " (removing species and all reactions with them)" << endl;
 	    
 	    std::string in=cl.get_param("in");
 	    std::string out=cl.get_param("out");
-	    std::string sp_name=cl.get_param("sp");
-	    std::vector<species> sp, sp_out;
-	    std::vector<reaction> re, re_out;
+	    rn_store st, st_out;
+	    std::vector<bool> removed;
+	    profile_phase ph("read");
 		
-	    if(read_jrnf_reaction_n(in, sp, re)) {
-	        cout << "Error at reading jrnf-file!" << std::endl;  
+	    if(read_network(in, st)) {
+	        cout << "Error at reading network file!" << std::endl;  
 	        return 1;
 	    }
 	
-	    filter_r_network_r(sp, re, sp_out, re_out, sp_name);
+	    ph.next("filter");
+	    if(!mark_removed_species(cl, st, removed))
+	        return 1;
+
+	    rn_filter_r(st, st_out, removed);
 		
-	    write_jrnf_reaction_n(out, sp_out, re_out);
+	    ph.next("write");
+	    if(write_network(out, st_out)) {
+	        cout << "Error at writing network file!" << std::endl;  
+	        return 1;
+	    }
     }
 
         
     /*
      * Transforms an reaction network from the file 'in' to the
-     * file 'out' by removing all species 'sp' maintaining reduced
+     * file 'out' by removing all species 'sp' / 'sp_file' maintaining reduced
      * reactions
      */
     
     if(cl.have_param("transform_rm_species_s")) {
-        if(!cl.have_param("in") || !cl.have_param("out") || !cl.have_param("sp"))  {
-	        cout << "You need to give parameters 'in', 'out' and 'sp'! Could not proceed!" << endl;
+        if(!cl.have_param("in") || !cl.have_param("out") || (!cl.have_param("sp") && !cl.have_param("sp_file")))  {
+	        cout << "You need to give parameters 'in', 'out' and 'sp' or 'sp_file'! Could not proceed!" << endl;
 	        return 1;  
 	    }      
       
-      	cout << "Executing: transform_rm_species_r!" << endl;
-        cout << " (removing a species from network - keep reduced reactions)" << endl;
+      	cout << "Executing: transform_rm_species_s!" << endl;
+        cout << " (removing species from network - keep reduced reactions)" << endl;
         std::string in=cl.get_param("in");
         std::string out=cl.get_param("out");
-        std::string sp_name=cl.get_param("sp");
-        std::vector<species> sp, sp_out;
-        std::vector<reaction> re, re_out;
+        rn_store st, st_out;
+        std::vector<bool> removed;
+        profile_phase ph("read");
     
-        if(read_jrnf_reaction_n(in, sp, re)) {
-            cout << "Error at reading jrnf-file!" << std::endl;  
+        if(read_network(in, st)) {
+            cout << "Error at reading network file!" << std::endl;  
             return 1;
         }      
 	
-        filter_r_network_s(sp, re, sp_out, re_out, sp_name);
+        ph.next("filter");
+        if(!mark_removed_species(cl, st, removed))
+            return 1;
+
+        rn_filter_s(st, st_out, removed);
 	
-    	write_jrnf_reaction_n(out, sp_out, re_out);
+        ph.next("write");
+        if(write_network(out, st_out)) {
+            cout << "Error at writing network file!" << std::endl;  
+            return 1;
+        }
     }   
 
     
@@ -314,617 +413,102 @@ int main(int argc, const char* argv[]) {
             return 1;  
         }      
 
-        std::vector<species> sp_1, sp_2, sp;  
-        std::vector<reaction> re_1, re_2, re;
+        rn_store st_1, st_2, st;
 	
         std::string in1=cl.get_param("in1");
         std::string in2=cl.get_param("in2");
+        profile_phase ph("read");
         
-        if(read_jrnf_reaction_n(in1, sp_1, re_1) || read_jrnf_reaction_n(in2, sp_2, re_2)) {
-            cout << "Error at reading jrnf-file!" << std::endl;  
+        if(read_network(in1, st_1) || read_network(in2, st_2)) {
+            cout << "Error at reading network file!" << std::endl;  
             return 1;
         }     
 	
-        combine_r_networks(sp_1, re_1, sp_2, re_2, sp, re);
+        ph.next("combine");
+        rn_combine(st_1, st_2, st);
 	
-        cout << "Combined network having " << sp.size() << " species and " << re.size() << " reactions." << endl;
+        cout << "Combined network having " << st.species_count() << " species and " << st.reaction_count() << " reactions." << endl;
 	
         std::string out=cl.get_param("out");
         cout << "Writing reaction network to " << out << endl;
-        write_jrnf_reaction_n(out, sp, re);
-    }
-
-    
-    /*
-     * Create simple Erdos-Renyi-Network with given number of
-     * nodes N and edges M. Possibility to choos if self loops
-     * and multiple edges are possible. It's also possible to generate
-     * directed networks.
-     */
-     
-    if(cl.have_param("create_ER_NM")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "ER_NM_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-      
-        std::cout << "mode: create_ER_NM  N=" << N << "   M=" << M << "   out=" << out << std::endl;
-	    
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
-		
-	std::cout << "creating network" << std::endl;
-	
-     	std::vector< pair<size_t, size_t> > edges;
-        create_erdos_renyi(edges, N, M,allow_multiple,self_loop, directed);
-	    
-	vector<species> sp;
-	vector<reaction> re;
-		
-        cout << "Simple output!" << std::endl;  
-		    
-	for(size_t t=0; t<N; ++t) 
-	    rm_add_species_ne(sp, t);
-		    
-	for(size_t t=0; t<edges.size(); ++t) 
-	    rm_1to1rev(re, edges[t].first, edges[t].second);  
-            
-	write_jrnf_reaction_n(out, sp, re);
-    }
-    
-   
-    /*
-     * Create reaction network from Erdos-Renyi model coupling linear reactions to nonlinear
-     */   
-   
-    if(cl.have_param("create_ER_NM_bi_C")) {
-        size_t N=cl.get_param_i("N");
-	size_t M=cl.get_param_i("M");
-	size_t C=cl.get_param_i("C");
-	std::string out= cl.have_param("out") ? cl.get_param("out") : "bi_nMC_network.jrnf";
-	bool self_loop=cl.have_param("self_loop");
-	bool directed=cl.have_param("directed");
-	bool allow_multiple=cl.have_param("allow_multiple");
-        bool limit_coupling=cl.have_param("limit_coupling");
-
-	
-	// Energy distribution of species and for activation energy
-	// TODO Not implemented yet
-	size_t energy_dist=0;   // 0 <-> linear [-1, 0]    
-	                        // 1 <-> logarithmic ln([0.01,1])
-	size_t aener_dist=0;    // 0 <-> linear [0, 1]
-	                        // 1 <-> logarithmic -ln([0.01,1])
-	
-        std::cout << "mode: create_ER_NM_bi_C  N=" << N << "   M=";
-        std::cout << M << "    C=" << C << "    out=" << out << std::endl;
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
-
-        if(limit_coupling)
-            std::cout << "limit coupling is active!" << std::endl;
-
-        cout << "Energy distribution is " << energy_dist;
-        cout << " and activation energy dist is " << aener_dist << endl;
-	
-	std::cout << "creating network" << std::endl;
-	
-     	std::vector< pair<size_t, size_t> > edges, couples;
-	create_erdos_renyi(edges, N, M, allow_multiple,self_loop, directed);
-        couple_erdos_renyi(couples, C, edges, limit_coupling, allow_multiple, self_loop, directed);
-	    
-	vector<species> sp;
-	vector<reaction> re;
-		
-        cout << "Output!" << std::endl;  
-
-	for(size_t t=0; t<N; ++t) 
-            rm_add_species(sp, t, energy_dist);    
-		
-        // Combine network link to "a+b->c+d"-reactions
-        for(size_t i=0; i<couples.size(); ++i) {
-            size_t r1=couples[i].first;
-            size_t r2=couples[i].second;
-		    
-            size_t a(edges[r1].first), b(edges[r2].first), 
-            c(edges[r1].second), d(edges[r2].second);
-	   
-            // create reaction using the macro function
-            rm_2to2rev(re, a, b, c, d, aener_dist);
-		    
-            // removing links connected from the edge list
-            edges.erase(edges.begin()+r2);
-            edges.erase(edges.begin()+r1);		  
-	}
-		
-    
-        // "Translate" all those unary reactions ("A->B")
-        for(size_t t=0; t<edges.size(); ++t) {
-            size_t a(edges[t].first), b(edges[t].second);
-			   
-            // create reaction using the macro function
-            rm_1to1rev(re, a, b, aener_dist);
+        ph.next("write");
+        if(write_network(out, st)) {
+            cout << "Error at writing network file!" << std::endl;  
+            return 1;
         }
-
-        write_jrnf_reaction_n(out, sp, re);	         
     }
 
-   
-    
-    /*
-     * Create Barabasi-Albert network with given number of edges and nodes.
-     */
-     
-    if(cl.have_param("create_BA_NM")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-	    std::string out= cl.have_param("out") ? cl.get_param("out") : "BA_NM_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-      
-        std::cout << "mode: create_BA_NM  N=" << N << "   M=" << M << "   out=" << out << std::endl;
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
-		
-        std::cout << "creating network" << std::endl;
-	
-     	std::vector< pair<size_t, size_t> > edges;
-        create_barabasi_albert(edges, N, M,allow_multiple,self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Simple output!" << std::endl;  
-		    
-        for(size_t t=0; t<N; ++t) 
-            rm_add_species_ne(sp, t);
-		    
-        for(size_t t=0; t<edges.size(); ++t) 
-            rm_1to1rev(re, edges[t].first, edges[t].second);  
-            
-        write_jrnf_reaction_n(out, sp, re);
-    }
-    
     
     /*
-     * Create Barabasi-Albert network and couple linear reactions to nonlinear 
+     * Executes the comma separated list of stages 'pipeline' on one network
+     * held in memory, e.g. create_BA_NM_bi_C,rm_species_s,sbml (see 
+     * pipeline.h).
      */
-    
-    if(cl.have_param("create_BA_NM_bi_C")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-        size_t C=cl.get_param_i("C");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "bi_NMC_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-        bool limit_coupling=cl.have_param("limit_coupling");
-	
-        // Energy distribution of species and for activation energy
-        // TODO Not implemented yet
-        size_t energy_dist=0;   // 0 <-> linear [-1, 0]    
-                                // 1 <-> logarithmic ln([0.01,1])
-        size_t aener_dist=0;    // 0 <-> linear [0, 1]
-                                // 1 <-> logarithmic -ln([0.01,1])
-	
-	       
-        std::cout << "mode: create_BA_NM_bi_C  N=" << N << "   M=";
-        std::cout << M << "    C=" << C << "    out=" << out << std::endl;
-	
-    	if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
 
-        if(limit_coupling)
-            std::cout << "limit coupling is active!" << std::endl;
-
-        cout << "Energy distribution is " << energy_dist;
-        cout << " and activation energy dist is " << aener_dist << endl;
-	
-
-        std::cout << "creating network" << std::endl;
-
-        std::vector< pair<size_t, size_t> > edges, couples;
-        create_barabasi_albert(edges, N, M,allow_multiple,self_loop, directed);
-
-	cout << "Doing coupling." << endl;
-        couple_barabasi_albert(couples, C, edges, limit_coupling, allow_multiple, self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Output!" << std::endl;  
-
-       for(size_t t=0; t<N; ++t) 
-           rm_add_species(sp, t, energy_dist);    
-		
-        // Combine network link to "a+b->c+d"-reactions
-        for(size_t i=0; i<couples.size(); ++i) {
-            size_t r1=couples[i].first;
-            size_t r2=couples[i].second;
-		    
-            size_t a(edges[r1].first), b(edges[r2].first), 
-                   c(edges[r1].second), d(edges[r2].second);
-			   
-            // create reaction using the macro function
-            rm_2to2rev(re, a, b, c, d, aener_dist);
-		    
-            // removing links connected from the edge list
-            edges.erase(edges.begin()+r2);
-            edges.erase(edges.begin()+r1);		  
-        }
-		
-        // "Translate" all those unary reactions ("A->B")
-        for(size_t t=0; t<edges.size(); ++t) {
-            size_t a(edges[t].first), b(edges[t].second);
-			   
-            // create reaction using the macro function
-            rm_1to1rev(re, a, b, aener_dist);
-        }
-			
-        write_jrnf_reaction_n(out, sp, re);	         
+    if(cl.have_param("pipeline")) {
+        cout << "Executing: pipeline!" << endl;
+        if(run_pipeline(cl, cl.get_param("pipeline"), seed))
+            return 1;
+        
+        return 0;
     }
 
-    
-    /*
-     * Create Watz-Strogatz network with given number of edges and nodes.
-     */
-     
-    if(cl.have_param("create_WS_NMalpha")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-        double alpha=cl.get_param_d("alpha");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "WS_NMalpha_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-      
-        std::cout << "mode: create_WS_NMalpha  N=" << N << "   M=" << M << "    alpha=" << alpha << "   out=" << out << std::endl;
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "multiple is active!" << std::endl;
 
-        std::cout << "creating network" << std::endl;
-	
-        std::vector< pair<size_t, size_t> > edges;
-        create_watts_strogatz(edges, N, M, alpha,allow_multiple,self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Simple output!" << std::endl;  
-		    
-        for(size_t t=0; t<N; ++t) 
-    	    rm_add_species_ne(sp, t);
-		    
-        for(size_t t=0; t<edges.size(); ++t) 
-            rm_1to1rev(re, edges[t].first, edges[t].second);  
-            
-        write_jrnf_reaction_n(out, sp, re);
-    }
-    
-    
     /*
-     * Create Watz-Strogatz network and couple linear reactions to nonlinear 
+     * Creates reaction networks from the different complex network types
+     * (Erdos-Renyi, Barabasi-Albert, Watts-Strogatz, Pan-Sinha and simple 
+     * modular). The '_bi_C' modes couple C pairs of linear reactions to
+     * nonlinear reactions. With 'ensemble=<count>' <count> networks are 
+     * generated on 'threads' threads, network i with seed <seed>+i written
+     * to the file 'out' numbered with i. With 'sweep' all combinations of
+     * parameter values are generated (see sweep.h).
      */
     
-    if(cl.have_param("create_WS_NMalpha_bi_C")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-        double alpha=cl.get_param_d("alpha");
-    	size_t C=cl.get_param_i("C");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "bi_NMalphaC_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-        bool limit_coupling=cl.have_param("limit_coupling");
-	
-        // Energy distribution of species and for activation energy
-        // TODO Not implemented yet
-        size_t energy_dist=0;   // 0 <-> linear [-1, 0]    
-                                // 1 <-> logarithmic ln([0.01,1])
-        size_t aener_dist=0;    // 0 <-> linear [0, 1]
-                                // 1 <-> logarithmic -ln([0.01,1])
-	
-        std::cout << "mode: create_WS_NMalpha_bi_C  N=" << N << "   M=";
-        std::cout << M << "    alpha=" << alpha << "   C=" << C;
-        std::cout << "    out=" << out << std::endl;
-	
-	    
-    	if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
+    for(size_t i=0; i<create_modes().size(); ++i) {
+        const std::string& mode=create_modes()[i].first;
+        if(!cl.have_param(mode))
+            continue;
 
-        if(limit_coupling)
-            std::cout << "limit coupling is active!" << std::endl;
-
-        cout << "Energy distribution is " << energy_dist;
-        cout << " and activation energy dist is " << aener_dist << endl;
-	
-        std::cout << "creating network" << std::endl;
-	
-        std::vector< pair<size_t, size_t> > edges, couples;
-        create_watts_strogatz(edges, N, M, alpha,allow_multiple,self_loop, directed);
-        couple_watts_strogatz(couples, C, edges, alpha, limit_coupling, allow_multiple, self_loop, directed);
-	    
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Output!" << std::endl;  
+        create_para p=read_create_para(cl, mode);
+        std::string out= cl.have_param("out") ? cl.get_param("out") : create_modes()[i].second;
 
-        for(size_t t=0; t<N; ++t) 
-            rm_add_species(sp, t, energy_dist);    
-	
-        // Combine network link to "a+b->c+d"-reactions
-        for(size_t i=0; i<couples.size(); ++i) {
-            size_t r1=couples[i].first;
-            size_t r2=couples[i].second;
-		    
-            size_t a(edges[r1].first), b(edges[r2].first), 
-                   c(edges[r1].second), d(edges[r2].second);
-			   
-            // create reaction using the macro function
-            rm_2to2rev(re, a, b, c, d, aener_dist);
-		    
-            // removing links connected from the edge list
-            edges.erase(edges.begin()+r2);
-            edges.erase(edges.begin()+r1);		  
+        if(cl.have_param("sweep")) {
+            std::cout << "mode: " << mode << " (sweep)" << std::endl;
+            profile_phase ph("sweep");
+            if(run_sweep(cl, p, out, seed))
+                return 1;
+            continue;
         }
-		
-    
-        // "Translate" all those unary reactions ("A->B")
-        for(size_t t=0; t<edges.size(); ++t) {
-            size_t a(edges[t].first), b(edges[t].second);
-			   
-            // create reaction using the macro function
-            rm_1to1rev(re, a, b, aener_dist);
-        }
-			
-        write_jrnf_reaction_n(out, sp, re);	         
-   }
 
-    
-   /*
-    * Creates a hierarchical modular reaction network 
-    */
-     
-    if(cl.have_param("create_PS_NMhmr")) {
-        size_t N=cl.get_param_i("N");
-        size_t M=cl.get_param_i("M");
-        size_t m=cl.get_param_i("m");
-        size_t h=cl.get_param_i("h");
-        double r=cl.get_param_d("r");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "PS_NMhmr_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-      
-        std::cout << "mode: create_PS_NMhmr  N=" << N << "   M=" << M << "    h=" << h << "   m=" << m << "   r=" << r << "   out=" << out << std::endl;
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-    	if(allow_multiple)
-            std::cout << "multiple is active!" << std::endl;
-	
+        if(!cl.have_param("ensemble"))
+            p.threads=thread_count(cl.have_param("threads") ? cl.get_param_i("threads") : 0);
 
-        std::cout << "creating network" << std::endl;
-	
-     	std::vector< pair<size_t, size_t> > edges;
-        create_pan_sinha(edges, N, M, h, m, r,allow_multiple,self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Simple output!" << std::endl;  
-		    
-        for(size_t t=0; t<N; ++t) 
-            rm_add_species_ne(sp, t);
-		    
-        for(size_t t=0; t<edges.size(); ++t) 
-            rm_1to1rev(re, edges[t].first, edges[t].second);  
-            
-        write_jrnf_reaction_n(out, sp, re);
-    }
+        print_create_para(p, out, std::cout);
 
-
-    /*
-     * Creates a hierarchical modular network (Pan-Sinha model) and couples the linear 
-     * reactions (A -> B) to a reaction network with nonlinear reactions.
-     */
- 
-    if(cl.have_param("create_PS_NMhmr_bi_C")) {
-        size_t N=cl.get_param_i("N");
-    	size_t M=cl.get_param_i("M");
-        size_t m=cl.get_param_i("m");
-        size_t h=cl.get_param_i("h");
-        double r=cl.get_param_d("r");
-        size_t C=cl.get_param_i("C");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "PS_NMhmr_bi_C_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-        bool limit_coupling=cl.have_param("limit_coupling");
-      
-        std::cout << "mode: create_PS_NMhmr_bi_C   N=" << N << "   M=" << M;
-        std::cout << "    h=" << h << "   m=" << m << "   r=" << r;
-        std::cout << "  C=" << C << "   out=" << out << std::endl;
-	
-        // Energy distribution of species and for activation energy
-        // TODO Not implemented yet
-        size_t energy_dist=0;   // 0 <-> linear [-1, 0]    
-                                // 1 <-> logarithmic ln([0.01,1])
-        size_t aener_dist=0;    // 0 <-> linear [0, 1]
-                                // 1 <-> logarithmic -ln([0.01,1])
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
-
-        if(limit_coupling)
-            std::cout << "limit coupling is active!" << std::endl;
-
-        cout << "Energy distribution is " << energy_dist;
-        cout << " and activation energy dist is " << aener_dist << endl;
-
-        std::vector< pair<size_t, size_t> > edges, couples;
-        create_pan_sinha(edges, N, M, h, m, r,allow_multiple,self_loop, directed);
-        couple_pan_sinha(couples, C, edges, h, m, r, limit_coupling, allow_multiple, self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Output!" << std::endl;  
-
-        for(size_t t=0; t<N; ++t) 
-    	    rm_add_species(sp, t, energy_dist);    
-		
-        // Combine network link to "a+b->c+d"-reactions
-        for(size_t i=0; i<couples.size(); ++i) {
-            size_t r1=couples[i].first;
-            size_t r2=couples[i].second;
-		    
-            size_t a(edges[r1].first), b(edges[r2].first), 
-                   c(edges[r1].second), d(edges[r2].second);
-		   
-            // create reaction using the macro function
-            rm_2to2rev(re, a, b, c, d, aener_dist);
-		    
-            // removing links connected from the edge list
-            edges.erase(edges.begin()+r2);
-            edges.erase(edges.begin()+r1);		  
-        }	
-    
-        // "Translate" all those unary reactions ("A->B")
-        for(size_t t=0; t<edges.size(); ++t) {
-            size_t a(edges[t].first), b(edges[t].second);
-			   
-            // create reaction using the macro function
-            rm_1to1rev(re, a, b, aener_dist);
+        if(!cl.have_param("ensemble")) {
+            if(create_network_file(p, seed, out, true))
+                return 1;
+            continue;
         }
-			
-        write_jrnf_reaction_n(out, sp, re);	         
-    }
-
-
-    /*
-     * Creates a simple modular network  with <m> modules and couples the linear 
-     * reactions (A -> B) to a reaction network with nonlinear reactions.
-     */
- 
-    if(cl.have_param("create_SM_NMmr_bi_C")) {
-        size_t N=cl.get_param_i("N");
-    	size_t M=cl.get_param_i("M");
-        size_t m=cl.get_param_i("m");
-        double r=cl.get_param_d("r");
-        size_t C=cl.get_param_i("C");
-        std::string out= cl.have_param("out") ? cl.get_param("out") : "SM_NMmr_bi_C_network.jrnf";
-        bool self_loop=cl.have_param("self_loop");
-        bool directed=cl.have_param("directed");
-        bool allow_multiple=cl.have_param("allow_multiple");
-        bool limit_coupling=cl.have_param("limit_coupling");
-      
-        std::cout << "mode: create_PS_NMhmr_bi_C   N=" << N << "   M=" << M;
-        std::cout << "   m=" << m << "   r=" << r;
-        std::cout << "  C=" << C << "   out=" << out << std::endl;
-	
-	
-        if(self_loop)
-            std::cout << "self loop is active!" << std::endl;
-	
-        if(directed)
-            std::cout << "directed is active!" << std::endl;
-	
-        if(allow_multiple)
-            std::cout << "allow multiple is active!" << std::endl;
-
-        if(limit_coupling)
-            std::cout << "limit coupling is active!" << std::endl;
-
-        std::vector< pair<size_t, size_t> > edges, couples;
-        create_simple_modular(edges, N, M, m, r,allow_multiple,self_loop, directed);
-        couple_simple_modular(couples, C, edges, m, r, limit_coupling, allow_multiple, self_loop, directed);
-	    
-        vector<species> sp;
-        vector<reaction> re;
-		
-        cout << "Output!" << std::endl;  
 
-        for(size_t t=0; t<N; ++t) 
-    	    rm_add_species(sp, t, 0);    
-		
-        // Combine network link to "a+b->c+d"-reactions
-        for(size_t i=0; i<couples.size(); ++i) {
-            size_t r1=couples[i].first;
-            size_t r2=couples[i].second;
-		    
-            size_t a(edges[r1].first), b(edges[r2].first), 
-                   c(edges[r1].second), d(edges[r2].second);
-		   
-            // create reaction using the macro function
-            rm_2to2rev(re, a, b, c, d, 0);
-		    
-            // removing links connected from the edge list
-            edges.erase(edges.begin()+r2);
-            edges.erase(edges.begin()+r1);		  
-        }	
-    
-        // "Translate" all those unary reactions ("A->B")
-        for(size_t t=0; t<edges.size(); ++t) {
-            size_t a(edges[t].first), b(edges[t].second);
-			   
-            // create reaction using the macro function
-            rm_1to1rev(re, a, b, 0);
+        size_t count=cl.get_param_i("ensemble");
+        size_t threads=thread_count(cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+        std::cout << "creating ensemble of " << count << " networks on " << threads;
+        std::cout << " threads (seeds " << seed << " to " << seed+count-1 << ")" << std::endl;
+        if(!p.fast)
+            std::cout << "generator=net_tools: networks are generated one at a time!" << std::endl;
+
+        std::atomic<size_t> failed(0);
+        profile_phase ph("ensemble");
+        parallel_for(count, threads, [&](size_t j) {
+            if(create_network_file(p, seed+j, ensemble_filename(out, j, count), false))
+                ++failed;
+        });
+
+        if(failed != 0) {
+            cout << failed << " of " << count << " networks could not be written!" << endl;
+            return 1;
         }
-			
-        write_jrnf_reaction_n(out, sp, re);	         
     }
     
     
@@ -937,22 +521,78 @@ int main(int argc, const char* argv[]) {
         cout << "          ===============" << endl;
         cout << " call with parameter 'info' or 'help' for showing this screen" << endl;
         cout << endl;
+        cout << " All modes writing jrnf or sbml files accept 'precision', the number" << endl;
+        cout << " of significant digits of floating point numbers (default: 0 - the" << endl;
+        cout << " shortest representation that is read back exactly, 6 - as before;" << endl;
+        cout << " sbml files: 6 digits as net_tools unless 'precision' is given)." << endl;
+        cout << " Reactions of large jrnf files are read and compressed files written" << endl;
+        cout << " on 'threads' threads (default: all cores)." << endl;
+        cout << " With 'profile' (or 'profile=<file>') wall time, cpu time and peak" << endl;
+        cout << " memory of every phase (read, generate, coupling, output, write, ...)" << endl;
+        cout << " are written as JSON to stdout (or the file) at the end of the run." << endl;
+        cout << endl;
         cout << "-> print_network" << endl;
         cout << " Load a jrnf-file and print its reactions to the screen" << endl;
         cout << " --> in - Name of jrnf-file to print" << endl;
+        cout << " --> reaction - print only the reaction with this index" << endl;
+        cout << endl;
+        cout << "-> convert_format" << endl;
+        cout << " Converts between textual jrnf and binary jrnfb files" << endl;
+        cout << " --> in - input file" << endl;
+        cout << " --> out - output file (jrnfb if name ends with '.jrnfb')" << endl;
+        cout << endl;
+        cout << " Input files can be jrnf or jrnfb (detected automatically), output" << endl;
+        cout << " files are written as jrnfb if their name ends with '.jrnfb'." << endl;
+        cout << " Files (also sbml) with names ending '.gz' are written gzip compressed," << endl;
+        cout << " compressed input files are detected automatically." << endl;
+        cout << endl;
+        cout << "-> network_stats" << endl;
+        cout << " Reads a network and writes statistics of it as JSON: species and" << endl;
+        cout << " reaction counts, reaction types ('2-2', '1-1', ...), degree" << endl;
+        cout << " distributions, self loops, multiple reactions (found by hash) and" << endl;
+        cout << " connected components" << endl;
+        cout << " --> in - input file" << endl;
+        cout << " --> out - JSON file (default: stdout)" << endl;
+        cout << endl;
+        cout << "-> export_incidence" << endl;
+        cout << " Writes the species - reaction incidence matrix (educt and product" << endl;
+        cout << " multiplicities) as little endian CSC / CSR arrays for mmap and / or" << endl;
+        cout << " the stoichiometric matrix as Matrix Market file" << endl;
+        cout << " --> in - input file" << endl;
+        cout << " --> out - binary file (layout see incidence_matrix.h)" << endl;
+        cout << " --> mtx - Matrix Market file" << endl;
         cout << endl;
         cout << "-> translate_jrnf_sbml" << endl;
         cout << " Reads a jrnf-file and writes it as sbml" << endl;
         cout << " --> in - input file" << endl;
         cout << " --> out - output file" << endl;
+        cout << " --> threads - number of threads formatting the sbml (default: all cores)" << endl;
+        cout << " --> stream - write while reading without keeping the network in memory" << endl;
+        cout << " --> sbml_format - 'net_tools' writes with write_sbml_reaction_n of" << endl;
+        cout << "     net_tools (one thread, same file, not compressed)" << endl;
         cout << endl;
         cout << "-> transform_rm_species_r, transform_rm_species_s" << endl;
-        cout << " Transforms a reaction network, removing on species. Either all" << endl;
+        cout << " Transforms a reaction network, removing species. Either all" << endl;
         cout << " reactions containing the species are removed ('_r') or only" << endl;
-        cout << " the species is removed from these reactions ('_s')." << endl;
+        cout << " the species are removed from these reactions ('_s')." << endl;
         cout << " --> in - input file" << endl;
         cout << " --> out - output file" << endl;
-        cout << " --> sp - name of the species to be removed" << endl;
+        cout << " --> sp - names of the species to be removed (comma separated)" << endl;
+        cout << " --> sp_file - file with names of species to be removed" << endl;
+        cout << " Names may contain the wildcards '*' and '?' (e.g. sp=X_*). All" << endl;
+        cout << " species are removed in one pass over the network." << endl;
+        cout << endl;
+        cout << "-> pipeline" << endl;
+        cout << " Executes several operations on a network held in memory (only" << endl;
+        cout << " the stages writing files write anything), e.g." << endl;
+        cout << "   pipeline=create_BA_NM_bi_C,rm_species_s:A_1+A_7,sbml:out.xml" << endl;
+        cout << " --> pipeline - comma separated stages '<name>' or '<name>:<arg>':" << endl;
+        cout << "     read[:<file>] (default 'in'), create_* (parameters as below)," << endl;
+        cout << "     rm_species_r[:<names>], rm_species_s[:<names>] (names separated" << endl;
+        cout << "     by '+', default 'sp' / 'sp_file'), combine[:<file>] (default 'in2')," << endl;
+        cout << "     write[:<file>] (jrnf / jrnfb, default 'out'), sbml[:<file>]" << endl;
+        cout << "     incidence[:<file>] (binary incidence matrix, default 'out')," << endl;
+        cout << "     mtx[:<file>] (Matrix Market, default 'mtx')" << endl;
         cout << endl;
         cout << "-> create_ER_NM, create_BA_NM, create_WS_NMbeta, create_PS_NMhmr " << endl;
         cout << "-> create_ER_NM_bi_C, create_BA_NM_bi_C, create_WS_NMbeta_biC," << endl;
@@ -968,6 +608,28 @@ int main(int argc, const char* argv[]) {
         cout << " --> directed - generate directed network" << endl;
         cout << " --> allow_multiple - allow multiple occurence of link" << endl;
         cout << " --> limit_coupling - coupling linear reactions with model specific constraints" << endl;
+        cout << " --> connected - couples join the components of the network first, so" << endl;
+        cout << "     it is connected if C and the links allow it (coupling of jrnf_tools," << endl;
+        cout << "     also for the links of net_tools; limit_coupling: no shared species)" << endl;
+        cout << " --> seed - seed for random numbers (default: current time)" << endl;
+        cout << " --> ensemble - generate this number of networks (numbered files)" << endl;
+        cout << " --> threads - number of threads for ensembles or the fast generator" << endl;
+        cout << "     (default: all cores)" << endl;
+        cout << " --> generator - 'fast' selects the parallel generators of jrnf_tools" << endl;
+        cout << "     (ER, BA, WS, PS, SM) and coupling instead of those of net_tools" << endl;
+        cout << "     (limit_coupling: coupled links share no species; the rejection" << endl;
+        cout << "     rate of the coupling is printed)" << endl;
+        cout << "     'net_tools' the generators of net_tools (default for single networks;" << endl;
+        cout << "     ensembles and sweeps use 'fast' by default, with 'net_tools' their" << endl;
+        cout << "     networks are generated one at a time because of the global rand())" << endl;
+        cout << " --> batch - nodes of BA networks added in parallel (fast generator," << endl;
+        cout << "     default 1 - exact sequential preferential attachment)" << endl;
+        cout << " --> sweep - generate networks for all combinations of the values of" << endl;
+        cout << "     N, M, C, alpha, h, m and r (each given as '<v>', '<v1>,<v2>,...'" << endl;
+        cout << "     or '<from>:<to>:<step>'), 'ensemble' networks per combination" << endl;
+        cout << " --> grid - file with lines '<parameter> <values>' for sweep (parameters" << endl;
+        cout << "     missing in the file are taken from the command line)" << endl;
+        cout << " --> manifest - list of files written by sweep (default: <out>.manifest)" << endl;
         cout << " --> beta - parameter for Watz Strogatz model" << endl;
         cout << " --> h - number of upper hierarchic level (PS)" << endl;
         cout << " --> m - size of 2. level modules (PS)" << endl;
@@ -0,0 +1,200 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Reading and writing of reaction networks in either the textual jrnf or
+ * the binary jrnfb format. Input files are recognized by their content,
+ * output files by their name (ending ".jrnfb" means binary, an additional
+ * ".gz" gzip compression).
+ */
+
+#ifndef __JRNF_TOOLS_NETWORK_IO_H__
+#define __JRNF_TOOLS_NETWORK_IO_H__
+
+#include <string>
+#include <vector>
+
+#include "net_tools/reaction_network.h"
+#include "net_tools/reaction_network_fileop.h"
+#include "network_sink.h"
+#include "jrnf_stream.h"
+#include "jrnf_mmap.h"
+#include "jrnf_binary.h"
+#include "reaction_store.h"
+
+
+inline bool is_jrnfb_filename(const std::string& filename) {
+    std::string f=strip_gz_filename(filename);
+    return f.size() >= 6 && f.compare(f.size()-6, 6, ".jrnfb") == 0;
+}
+
+
+/*
+ * Reads the opened network file `f` (jrnf or jrnfb, see input_file) into
+ * the network sink `s`. The format is given by the first bytes, so the
+ * file is opened (and decompressed) only once. Returns 0 on success, 1 on
+ * errors and 2 if the format is unknown.
+ */
+
+template<typename sink_t>
+int read_network(input_file& f, sink_t& s) {
+    if(is_jrnfb_data(f.begin(), f.end())) {
+        jrnfb_file b;
+        int r=b.open(f);
+        if(r == 0)
+            b.emit_all(s);
+        return r;
+    }
+
+    return parse_jrnf(f, s, io_threads());
+}
+
+
+/*
+ * Reads the network file `filename` (jrnf or jrnfb) into the network sink
+ * `s`, compressed jrnf-files are decompressed while they are parsed.
+ * Return values as above (1 also if the file can't be opened).
+ */
+
+template<typename sink_t>
+int read_network(const std::string& filename, sink_t& s) {
+    input_file f;
+    if(!f.open(filename, false))
+        return 1;
+
+    return read_network(f, s);
+}
+
+
+/*
+ * Reads the network file `filename` (opened as `f`) into the vectors `sp`
+ * and `re`. Text files of other jrnf versions are given to 
+ * read_jrnf_reaction_n. Returns 0 on success.
+ */
+
+inline int read_network(const std::string& filename, input_file& f,
+                        std::vector<species>& sp, std::vector<reaction>& re) {
+    rn_vector_sink s(sp, re);
+    int r=read_network(f, s);
+    f.close();
+
+    if(r == 2)
+        return read_jrnf_reaction_n(filename, sp, re);
+
+    return r;
+}
+
+
+inline int read_network(const std::string& filename, std::vector<species>& sp, std::vector<reaction>& re) {
+    input_file f;
+    if(!f.open(filename, false))
+        return 1;
+
+    return read_network(filename, f, sp, re);
+}
+
+
+/*
+ * Network sink writing jrnf or jrnfb depending on the filename.
+ */
+
+class network_writer {
+    jrnf_writer text;
+    jrnfb_writer binary;
+    bool is_binary;
+
+public:
+    network_writer() : is_binary(false) {}
+
+    bool open(const std::string& filename) {
+        is_binary=is_jrnfb_filename(filename);
+        return is_binary ? binary.open(filename) : text.open(filename);
+    }
+
+    void reserve(size_t sp_count, size_t re_count) {
+        if(is_binary)
+            binary.reserve(sp_count, re_count);
+    }
+
+    // Exact counts (see jrnf_writer::set_counts)
+    void set_counts(size_t sp_count, size_t re_count) {
+        if(is_binary)
+            binary.reserve(sp_count, re_count);
+        else
+            text.set_counts(sp_count, re_count);
+    }
+
+    void add_species(const std::string& name, bool constant, double energy) {
+        if(is_binary)
+            binary.add_species(name, constant, energy);
+        else
+            text.add_species(name, constant, energy);
+    }
+
+    void add_species(const species& s) {
+        add_species(s.get_name(), s.is_constant(), s.get_energy());
+    }
+
+    void add_reaction(bool reversible, double c, double k, double k_b, double activation,
+                      const std::pair<size_t, size_t>* educts, size_t n_educts,
+                      const std::pair<size_t, size_t>* products, size_t n_products) {
+        if(is_binary)
+            binary.add_reaction(reversible, c, k, k_b, activation, educts, n_educts, products, n_products);
+        else
+            text.add_reaction(reversible, c, k, k_b, activation, educts, n_educts, products, n_products);
+    }
+
+    void add_reaction(const reaction& r) {
+        const std::vector< std::pair<size_t, size_t> >& ed=r.get_educts();
+        const std::vector< std::pair<size_t, size_t> >& pr=r.get_products();
+        add_reaction(r.is_reversible(), r.get_c(), r.get_k(), r.get_k_b(), r.get_activation(),
+                     ed.data(), ed.size(), pr.data(), pr.size());
+    }
+
+    bool close() {
+        return is_binary ? binary.close() : text.close();
+    }
+};
+
+
+/*
+ * Writes the network given by `sp` and `re` to `filename` (jrnf or jrnfb).
+ * Returns 0 on success.
+ */
+
+inline int write_network(const std::string& filename, const std::vector<species>& sp, const std::vector<reaction>& re) {
+    network_writer w;
+    if(!w.open(filename))
+        return 1;
+
+    w.set_counts(sp.size(), re.size());
+    for(size_t i=0; i<sp.size(); ++i)
+        w.add_species(sp[i]);
+
+    for(size_t i=0; i<re.size(); ++i)
+        w.add_reaction(re[i]);
+
+    return w.close() ? 0 : 1;
+}
+
+
+
+/*
+ * Writes the network `st` to `filename` (jrnf or jrnfb). Returns 0 on 
+ * success.
+ */
+
+inline int write_network(const std::string& filename, const rn_store& st) {
+    if(is_jrnfb_filename(filename))
+        return write_jrnfb(filename, st) ? 0 : 1;
+
+    jrnf_writer w;
+    if(!w.open(filename))
+        return 1;
+
+    w.set_counts(st.species_count(), st.reaction_count());
+    st.emit(w);
+    return w.close() ? 0 : 1;
+}
+
+
+#endif
@@ -0,0 +1,60 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Network sink that fills the species and reaction vectors of net_tools.
+ * A network sink is everything that networks can be written into with
+ *   reserve(<#species>, <#reactions>)     (hint, may be ignored)
+ *   add_species(name, constant, energy)
+ *   add_reaction(reversible, c, k, k_b, activation,
+ *                educts, #educts, products, #products)
+ * where educts and products are arrays of (species id, multiplicity)
+ * pairs. Other sinks are jrnf_writer (jrnf_stream.h).
+ */
+
+#ifndef __JRNF_TOOLS_NETWORK_SINK_H__
+#define __JRNF_TOOLS_NETWORK_SINK_H__
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "net_tools/reaction_network.h"
+
+
+class rn_vector_sink {
+    std::vector<species>& sp;
+    std::vector<reaction>& re;
+
+public:
+    rn_vector_sink(std::vector<species>& sp_, std::vector<reaction>& re_) : sp(sp_), re(re_) {}
+
+    void reserve(size_t sp_count, size_t re_count) {
+        sp.reserve(sp.size()+sp_count);
+        re.reserve(re.size()+re_count);
+    }
+
+    void add_species(const std::string& name, bool constant, double energy) {
+        sp.push_back(species(sp.size(), name, constant, energy));
+    }
+
+    void add_reaction(bool reversible, double c, double k, double k_b, double activation,
+                      const std::pair<size_t, size_t>* educts, size_t n_educts,
+                      const std::pair<size_t, size_t>* products, size_t n_products) {
+        re.push_back(reaction());
+        reaction& r=re.back();
+        r.set_reversible(reversible);
+        r.set_c(c);
+        r.set_k(k);
+        r.set_k_b(k_b);
+        r.set_activation(activation);
+
+        for(size_t i=0; i<n_educts; ++i)
+            r.add_educt(educts[i].first, educts[i].second);
+
+        for(size_t i=0; i<n_products; ++i)
+            r.add_product(products[i].first, products[i].second);
+    }
+};
+
+
+#endif
@@ -0,0 +1,204 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Statistics of a reaction network computed in one pass while it is read
+ * (network_stats is a network sink, see network_sink.h): species and
+ * reaction counts, reaction types (molecularity of educts - products),
+ * degree distributions of the species, self loops, multiple reactions
+ * and connected components (union-find over the species of every
+ * reaction). The result is written as JSON.
+ */
+
+#ifndef __JRNF_TOOLS_NETWORK_STATS_H__
+#define __JRNF_TOOLS_NETWORK_STATS_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+
+#include "rng.h"
+#include "union_find.h"
+#include "edge_generators.h"
+
+
+class network_stats {
+    size_t sp_count, constant_count, re_count, reversible_count;
+    size_t self_loops, catalytic, multiple;
+    std::map< std::pair<size_t, size_t>, size_t > types;     // (#educts, #products) -> count
+    std::vector<size_t> degree, educt_degree, product_degree;
+    std::vector<size_t> last;        // last reaction a species was counted for
+    union_find components;
+    edge_set seen;                   // hashes of reactions
+    std::vector< std::pair<size_t, size_t> > ed, pr;
+
+    static size_t molecules(const std::pair<size_t, size_t>* s, size_t n) {
+        size_t m=0;
+        for(size_t i=0; i<n; ++i)
+            m += s[i].second;
+        return m;
+    }
+
+    static void hash_side(uint64_t& h, const std::vector< std::pair<size_t, size_t> >& s) {
+        for(size_t i=0; i<s.size(); ++i) {
+            h ^= s[i].first;
+            h=splitmix64(h);
+            h ^= s[i].second;
+            h=splitmix64(h);
+        }
+        h ^= 0x5bd1e995;     // separates the sides
+        h=splitmix64(h);
+    }
+
+    static std::vector<size_t> histogram(const std::vector<size_t>& d) {
+        std::vector<size_t> h;
+        for(size_t i=0; i<d.size(); ++i) {
+            if(d[i] >= h.size())
+                h.resize(d[i]+1, 0);
+            ++h[d[i]];
+        }
+        return h;
+    }
+
+    static void write_array(std::ostream& o, const std::vector<size_t>& v) {
+        o << "[";
+        for(size_t i=0; i<v.size(); ++i)
+            o << (i == 0 ? "" : ", ") << v[i];
+        o << "]";
+    }
+
+public:
+    network_stats() : sp_count(0), constant_count(0), re_count(0), reversible_count(0),
+                      self_loops(0), catalytic(0), multiple(0), seen(0, true) {}
+
+
+    /*
+     * Network sink interface (all species have to be added before the
+     * first reaction)
+     */
+
+    void reserve(size_t sp_c, size_t re_c) {
+        seen=edge_set(re_c, true);
+        degree.reserve(sp_c);
+    }
+
+    void add_species(const std::string&, bool constant, double) {
+        ++sp_count;
+        if(constant)
+            ++constant_count;
+    }
+
+    void add_reaction(bool reversible, double, double, double, double,
+                      const std::pair<size_t, size_t>* educts, size_t n_educts,
+                      const std::pair<size_t, size_t>* products, size_t n_products) {
+        if(re_count == 0) {
+            degree.assign(sp_count, 0);
+            educt_degree.assign(sp_count, 0);
+            product_degree.assign(sp_count, 0);
+            last.assign(sp_count, ~size_t(0));
+            components.reset(sp_count);
+        }
+
+        ++types[std::make_pair(molecules(educts, n_educts), molecules(products, n_products))];
+        if(reversible)
+            ++reversible_count;
+
+        // degrees (every species once per reaction), components
+        size_t first=(n_educts != 0) ? educts[0].first : (n_products != 0 ? products[0].first : 0);
+        for(size_t i=0; i<n_educts+n_products; ++i) {
+            size_t s=(i < n_educts) ? educts[i].first : products[i-n_educts].first;
+            if(last[s] != re_count) {
+                last[s]=re_count;
+                ++degree[s];
+            }
+            ++(i < n_educts ? educt_degree : product_degree)[s];
+            components.unite(first, s);
+        }
+
+        // canonical form: sorted sides, for reversible reactions the smaller
+        // side first
+        ed.assign(educts, educts+n_educts);
+        pr.assign(products, products+n_products);
+        std::sort(ed.begin(), ed.end());
+        std::sort(pr.begin(), pr.end());
+
+        if(ed == pr)
+            ++self_loops;
+        else
+            for(size_t i=0, j=0; i<ed.size() && j<pr.size(); )
+                if(ed[i].first == pr[j].first) {
+                    ++catalytic;
+                    break;
+                } else if(ed[i].first < pr[j].first)
+                    ++i;
+                else
+                    ++j;
+
+        if(reversible && pr < ed)
+            ed.swap(pr);
+
+        uint64_t h=reversible ? 1 : 2;
+        hash_side(h, ed);
+        hash_side(h, pr);
+        if(!seen.insert_key(std::min(h, ~uint64_t(0)-2)))
+            ++multiple;
+
+        ++re_count;
+    }
+
+
+    /*
+     * Writes the statistics as JSON object to `o`.
+     */
+
+    void write_json(std::ostream& o) {
+        if(re_count == 0) {
+            degree.assign(sp_count, 0);
+            educt_degree.assign(sp_count, 0);
+            product_degree.assign(sp_count, 0);
+            components.reset(sp_count);
+        }
+
+        // components: number, largest and isolated species
+        size_t largest=0, isolated=0;
+        for(size_t i=0; i<sp_count; ++i) {
+            largest=std::max(largest, components.set_size(i));
+            if(degree[i] == 0)
+                ++isolated;
+        }
+
+        size_t r_11=types.count(std::make_pair(1, 1)) ? types[std::make_pair(1, 1)] : 0;
+        size_t r_22=types.count(std::make_pair(2, 2)) ? types[std::make_pair(2, 2)] : 0;
+
+        o << "{\n";
+        o << "  \"species\": " << sp_count << ",\n";
+        o << "  \"constant_species\": " << constant_count << ",\n";
+        o << "  \"reactions\": " << re_count << ",\n";
+        o << "  \"reversible_reactions\": " << reversible_count << ",\n";
+        o << "  \"reaction_types\": {";
+        for(std::map< std::pair<size_t, size_t>, size_t >::const_iterator i=types.begin(); i != types.end(); ++i)
+            o << (i == types.begin() ? "" : ", ") << "\"" << i->first.first << "-" << i->first.second << "\": " << i->second;
+        o << "},\n";
+        o << "  \"fraction_1_1\": " << (re_count == 0 ? 0.0 : double(r_11)/re_count) << ",\n";
+        o << "  \"fraction_2_2\": " << (re_count == 0 ? 0.0 : double(r_22)/re_count) << ",\n";
+        o << "  \"self_loops\": " << self_loops << ",\n";
+        o << "  \"catalytic_reactions\": " << catalytic << ",\n";
+        o << "  \"multiple_reactions\": " << multiple << ",\n";
+        o << "  \"components\": " << components.set_count() << ",\n";
+        o << "  \"largest_component\": " << largest << ",\n";
+        o << "  \"isolated_species\": " << isolated << ",\n";
+        o << "  \"degree_distribution\": ";
+        write_array(o, histogram(degree));
+        o << ",\n  \"educt_degree_distribution\": ";
+        write_array(o, histogram(educt_degree));
+        o << ",\n  \"product_degree_distribution\": ";
+        write_array(o, histogram(product_degree));
+        o << "\n}" << std::endl;
+    }
+};
+
+
+#endif
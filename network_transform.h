@@ -0,0 +1,254 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Transformations of reaction networks stored in rn_store: removing
+ * species (with or without the reactions they take part in) and combining
+ * two networks. Species are found by name with species_index.
+ */
+
+#ifndef __JRNF_TOOLS_NETWORK_TRANSFORM_H__
+#define __JRNF_TOOLS_NETWORK_TRANSFORM_H__
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <utility>
+
+#include "reaction_store.h"
+#include "species_index.h"
+
+
+/*
+ * Returns true if the name [s, s+n) matches the pattern `p`, which may 
+ * contain the wildcards '*' (any sequence) and '?' (any character).
+ */
+
+inline bool glob_match(const char* p, const char* s, size_t n) {
+    const char* e=s+n;
+    const char* star=0;
+    const char* star_s=0;
+
+    while(s != e) {
+        if(*p == '*') {
+            star=p++;
+            star_s=s;
+        } else if(*p != 0 && (*p == '?' || *p == *s)) {
+            ++p;
+            ++s;
+        } else if(star != 0) {
+            p=star+1;
+            s=++star_s;
+        } else
+            return false;
+    }
+
+    while(*p == '*')
+        ++p;
+    return *p == 0;
+}
+
+
+/*
+ * Appends the comma separated species names (or patterns) of `list` to
+ * `names`.
+ */
+
+inline void split_species_list(const std::string& list, std::vector<std::string>& names) {
+    size_t b=0;
+    while(b <= list.size()) {
+        size_t e=list.find(',', b);
+        if(e == std::string::npos)
+            e=list.size();
+
+        if(e > b)
+            names.push_back(list.substr(b, e-b));
+        b=e+1;
+    }
+}
+
+
+/*
+ * Appends the species names (or patterns) of file `filename` to `names`. 
+ * Names are separated by whitespace, lines starting with '#' are ignored.
+ * Returns false if the file can't be read.
+ */
+
+inline bool read_species_list(const std::string& filename, std::vector<std::string>& names) {
+    std::ifstream in(filename.c_str());
+    if(!in)
+        return false;
+
+    std::string line;
+    while(std::getline(in, line)) {
+        size_t b=line.find_first_not_of(" \t\r");
+        if(b == std::string::npos || line[b] == '#')
+            continue;
+
+        while(b != std::string::npos) {
+            size_t e=line.find_first_of(" \t\r", b);
+            names.push_back(line.substr(b, e == std::string::npos ? std::string::npos : e-b));
+            b=(e == std::string::npos) ? e : line.find_first_not_of(" \t\r", e);
+        }
+    }
+
+    return !in.bad();
+}
+
+
+/*
+ * Marks all species of `st` named `name` in the bitmap `removed`. If the
+ * name contains wildcards ('*', '?') all species matching it are marked.
+ * Names are looked up in `idx` if they are unique, otherwise (as for
+ * wildcards) all species are compared. Returns the number of marked species.
+ */
+
+inline size_t rn_mark_species(const rn_store& st, const species_index& idx, 
+                              const std::string& name, std::vector<bool>& removed) {
+    removed.resize(st.species_count(), false);
+
+    if(idx.unique() && name.find_first_of("*?") == std::string::npos) {
+        size_t id=idx.find(name);
+        if(id == species_index::npos)
+            return 0;
+
+        removed[id]=true;
+        return 1;
+    }
+
+    size_t count=0;
+    for(size_t i=0; i<st.species_count(); ++i) 
+        if(glob_match(name.c_str(), st.names.data()+st.name_off[i], st.name_off[i+1]-st.name_off[i])) {
+            removed[i]=true;
+            ++count;
+        }
+
+    return count;
+}
+
+
+/*
+ * Copies all species of `in` not marked in `removed` to `out` and returns
+ * the new ids of all species of `in` (npos for the removed).
+ */
+
+inline std::vector<size_t> rn_copy_species_except(const rn_store& in, rn_store& out, const std::vector<bool>& removed) {
+    std::vector<size_t> new_id(in.species_count(), species_index::npos);
+
+    for(size_t i=0; i<in.species_count(); ++i)
+        if(!removed[i]) {
+            new_id[i]=out.species_count();
+            in.emit_species(out, i);
+        }
+
+    return new_id;
+}
+
+
+/*
+ * Writes the network `in` without the species marked in `removed` and
+ * without all reactions they take part in to `out` (one pass over the
+ * reactions, independent of the number of removed species).
+ */
+
+inline void rn_filter_r(const rn_store& in, rn_store& out, const std::vector<bool>& removed) {
+    out.clear();
+    out.reserve(in.species_count(), in.reaction_count());
+    std::vector<size_t> new_id=rn_copy_species_except(in, out, removed);
+    std::vector< std::pair<size_t, size_t> > st;
+
+    for(size_t r=0; r<in.reaction_count(); ++r) {
+        bool keep=true;
+        st.assign(in.educts(r), in.products(r)+in.product_count(r));
+
+        for(size_t j=0; j<st.size() && keep; ++j) {
+            keep=!removed[st[j].first];
+            st[j].first=new_id[st[j].first];
+        }
+
+        if(keep)
+            out.add_reaction(in.reversible[r] != 0, in.c[r], in.k[r], in.k_b[r], in.activation[r],
+                             st.data(), in.educt_count(r), st.data()+in.educt_count(r), in.product_count(r));
+    }
+}
+
+
+/*
+ * Writes the network `in` without the species marked in `removed` to 
+ * `out`. Reactions keep their other educts and products (also if none are
+ * left, as filter_r_network_s).
+ */
+
+inline void rn_filter_s(const rn_store& in, rn_store& out, const std::vector<bool>& removed) {
+    out.clear();
+    out.reserve(in.species_count(), in.reaction_count());
+    std::vector<size_t> new_id=rn_copy_species_except(in, out, removed);
+    std::vector< std::pair<size_t, size_t> > ed, pr;
+
+    for(size_t r=0; r<in.reaction_count(); ++r) {
+        ed.clear();
+        pr.clear();
+
+        for(size_t j=0; j<in.educt_count(r); ++j)
+            if(!removed[in.educts(r)[j].first])
+                ed.push_back(std::make_pair(new_id[in.educts(r)[j].first], in.educts(r)[j].second));
+
+        for(size_t j=0; j<in.product_count(r); ++j)
+            if(!removed[in.products(r)[j].first])
+                pr.push_back(std::make_pair(new_id[in.products(r)[j].first], in.products(r)[j].second));
+
+        out.add_reaction(in.reversible[r] != 0, in.c[r], in.k[r], in.k_b[r], in.activation[r],
+                         ed.data(), ed.size(), pr.data(), pr.size());
+    }
+}
+
+
+/*
+ * Combines the networks `a` and `b` to `out`. Species of both networks are
+ * merged by name (species of `a` first, properties of the first occurrence
+ * are kept), the reactions of `a` are followed by those of `b`. Expected
+ * runtime is linear in the size of both networks.
+ */
+
+inline void rn_combine(const rn_store& a, const rn_store& b, rn_store& out) {
+    out.clear();
+    out.reserve(a.species_count()+b.species_count(), a.reaction_count()+b.reaction_count());
+
+    species_index idx(out);
+    std::vector<size_t> id_a(a.species_count()), id_b(b.species_count());
+
+    for(size_t n=0; n<2; ++n) {
+        const rn_store& in=(n == 0) ? a : b;
+        std::vector<size_t>& ids=(n == 0) ? id_a : id_b;
+
+        for(size_t i=0; i<in.species_count(); ++i) {
+            size_t nb=in.name_off[i];
+            size_t id=idx.find(in.names.data()+nb, in.name_off[i+1]-nb);
+
+            if(id == species_index::npos) {
+                id=out.species_count();
+                in.emit_species(out, i);
+                idx.insert(id);
+            }
+
+            ids[i]=id;
+        }
+    }
+
+    std::vector< std::pair<size_t, size_t> > st;
+    for(size_t n=0; n<2; ++n) {
+        const rn_store& in=(n == 0) ? a : b;
+        const std::vector<size_t>& ids=(n == 0) ? id_a : id_b;
+
+        for(size_t r=0; r<in.reaction_count(); ++r) {
+            st.assign(in.educts(r), in.products(r)+in.product_count(r));
+            for(size_t j=0; j<st.size(); ++j)
+                st[j].first=ids[st[j].first];
+
+            out.add_reaction(in.reversible[r] != 0, in.c[r], in.k[r], in.k_b[r], in.activation[r],
+                             st.data(), in.educt_count(r), st.data()+in.educt_count(r), in.product_count(r));
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,50 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Fast formatting of numbers for the text writers (jrnf, sbml) with
+ * std::to_chars, appending directly to an output buffer.
+ */
+
+#ifndef __JRNF_TOOLS_NUMBER_FORMAT_H__
+#define __JRNF_TOOLS_NUMBER_FORMAT_H__
+
+#include <string>
+#include <charconv>
+#include <cstddef>
+
+
+/*
+ * Number of significant digits used for floating point numbers in text
+ * files. 0 (default) selects the shortest representation that is read
+ * back as the same double, 6 gives the output of iostreams / "%g". Set
+ * once (parameter 'precision') before anything is written.
+ */
+
+inline int& output_precision() {
+    static int p=0;
+    return p;
+}
+
+
+inline void append_number(std::string& b, size_t v) {
+    char tmp[24];
+    std::to_chars_result r=std::to_chars(tmp, tmp+sizeof(tmp), v);
+    b.append(tmp, r.ptr-tmp);
+}
+
+
+/*
+ * Appends `v` with `precision` significant digits (0 - shortest round trip
+ * representation) to `b`.
+ */
+
+inline void append_number(std::string& b, double v, int precision) {
+    char tmp[32];
+    std::to_chars_result r=(precision == 0) ?
+        std::to_chars(tmp, tmp+sizeof(tmp), v) :
+        std::to_chars(tmp, tmp+sizeof(tmp), v, std::chars_format::general, precision);
+    b.append(tmp, r.ptr-tmp);
+}
+
+
+#endif
@@ -0,0 +1,248 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Pipeline mode: several operations (generate / read, transform, write)
+ * are executed one after the other on a network held in memory, so no
+ * intermediate files are written and parsed again. The stages are given
+ * as comma separated list, e.g.
+ *   pipeline=create_BA_NM_bi_C,rm_species_s:A_1+A_7,sbml:out.xml
+ * Every stage is "<name>" or "<name>:<argument>":
+ *   read[:<file>]            - reads network (default: parameter 'in')
+ *   create_*                 - generates network (parameters as the mode,
+ *                              also 'threads')
+ *   rm_species_r[:<names>]   - removes species and their reactions
+ *   rm_species_s[:<names>]   - removes species from reactions
+ *                              (names separated by '+', default: 'sp' and
+ *                              'sp_file' as in the transform modes)
+ *   combine[:<file>]         - combines with network (default: 'in2')
+ *   write[:<file>]           - writes jrnf / jrnfb (default: 'out')
+ *   sbml[:<file>]            - writes sbml (default: 'out', with
+ *                              net_tools for 'sbml_format=net_tools')
+ *   incidence[:<file>]       - writes the incidence matrix as binary CSC /
+ *                              CSR arrays (default: 'out')
+ *   mtx[:<file>]             - writes the stoichiometric matrix as Matrix
+ *                              Market file (default: 'mtx')
+ * The first stage has to be read or a create_* stage.
+ */
+
+#ifndef __JRNF_TOOLS_PIPELINE_H__
+#define __JRNF_TOOLS_PIPELINE_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "tools/cl_para.h"
+#include "reaction_store.h"
+#include "species_index.h"
+#include "network_transform.h"
+#include "network_io.h"
+#include "sbml_writer.h"
+#include "incidence_matrix.h"
+#include "create_modes.h"
+#include "profile.h"
+
+
+/*
+ * Collects the names (or patterns) of species given by the parameters 'sp'
+ * (comma separated) and 'sp_file' in `names`. Returns false on errors.
+ */
+
+inline bool removed_species_names(cl_para& cl, std::vector<std::string>& names) {
+    if(cl.have_param("sp"))
+        split_species_list(cl.get_param("sp"), names);
+
+    if(cl.have_param("sp_file") && !read_species_list(cl.get_param("sp_file"), names)) {
+        std::cout << "Error at reading species file " << cl.get_param("sp_file") << "!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+/*
+ * Marks all species of `st` matching one of `names` in `removed`. Returns
+ * false if a name (or pattern) matches no species.
+ */
+
+inline bool mark_removed_species(const rn_store& st, const std::vector<std::string>& names, std::vector<bool>& removed) {
+    species_index idx(st);
+    removed.assign(st.species_count(), false);
+    size_t count=0;
+    bool found=true;
+
+    for(size_t i=0; i<names.size(); ++i)
+        if(rn_mark_species(st, idx, names[i], removed) == 0) {
+            std::cout << "Species " << names[i] << " not found!" << std::endl;
+            found=false;
+        }
+
+    if(!found)
+        return false;
+
+    for(size_t i=0; i<removed.size(); ++i)
+        if(removed[i])
+            ++count;
+
+    std::cout << "Removing " << count << " of " << st.species_count() << " species." << std::endl;
+    return true;
+}
+
+
+/*
+ * Splits the pipeline specification `spec` into (stage, argument) pairs.
+ */
+
+inline std::vector< std::pair<std::string, std::string> > parse_pipeline(const std::string& spec) {
+    std::vector<std::string> stages;
+    split_species_list(spec, stages);
+
+    std::vector< std::pair<std::string, std::string> > res;
+    for(size_t i=0; i<stages.size(); ++i) {
+        size_t c=stages[i].find(':');
+        if(c == std::string::npos)
+            res.push_back(std::make_pair(stages[i], std::string()));
+        else
+            res.push_back(std::make_pair(stages[i].substr(0, c), stages[i].substr(c+1)));
+    }
+
+    return res;
+}
+
+
+/*
+ * Returns the argument `arg` of a stage or, if it is empty, the command
+ * line parameter `param`. Empty if neither is given.
+ */
+
+inline std::string pipeline_arg(cl_para& cl, const std::string& arg, const char* param) {
+    if(!arg.empty())
+        return arg;
+
+    return cl.have_param(param) ? cl.get_param(param) : std::string();
+}
+
+
+/*
+ * Executes the pipeline `spec` (see above). Random numbers of create
+ * stages are determined by `seed`. Returns 0 on success.
+ */
+
+inline int run_pipeline(cl_para& cl, const std::string& spec, uint64_t seed) {
+    std::vector< std::pair<std::string, std::string> > stages=parse_pipeline(spec);
+    rn_store st, tmp;
+
+    for(size_t i=0; i<stages.size(); ++i) {
+        const std::string& name=stages[i].first;
+        const std::string& arg=stages[i].second;
+        bool source=(name == "read" || name.compare(0, 7, "create_") == 0);
+
+        if((i == 0) != source) {
+            std::cout << "Pipeline has to start with (only one) 'read' or 'create_*' stage!" << std::endl;
+            return 1;
+        }
+
+        std::cout << "pipeline stage " << i << ": " << name << (arg.empty() ? "" : ":") << arg << std::endl;
+
+        // create_* stages record their own phases (generate, coupling, output)
+        profile_phase ph;
+        if(name.compare(0, 7, "create_") != 0)
+            ph.next(name);
+
+        if(name == "read" || name == "combine") {
+            std::string in=pipeline_arg(cl, arg, name == "read" ? "in" : "in2");
+            if(in.empty()) {
+                std::cout << "No input file given for stage " << name << "!" << std::endl;
+                return 1;
+            }
+
+            tmp.clear();
+            if(read_network(in, name == "read" ? st : tmp)) {
+                std::cout << "Error at reading network file " << in << "!" << std::endl;
+                return 1;
+            }
+
+            if(name == "combine") {
+                rn_store a;
+                std::swap(a, st);
+                rn_combine(a, tmp, st);
+            }
+        } else if(name.compare(0, 7, "create_") == 0) {
+            bool known=false;
+            for(size_t j=0; j<create_modes().size(); ++j)
+                known = known || create_modes()[j].first == name;
+
+            if(!known) {
+                std::cout << "Unknown create mode " << name << "!" << std::endl;
+                return 1;
+            }
+
+            create_para p=read_create_para(cl, name);
+            p.threads=thread_count(cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+            print_create_para(p, "-", std::cout);
+            create_network(p, seed, st, true);
+        } else if(name == "rm_species_r" || name == "rm_species_s") {
+            std::vector<std::string> names;
+            std::vector<bool> removed;
+
+            if(!arg.empty()) {
+                for(size_t b=0, e; b <= arg.size(); b=e+1) {
+                    e=arg.find('+', b);
+                    if(e == std::string::npos)
+                        e=arg.size();
+                    if(e > b)
+                        names.push_back(arg.substr(b, e-b));
+                }
+            } else if(!removed_species_names(cl, names))
+                return 1;
+
+            if(!mark_removed_species(st, names, removed))
+                return 1;
+
+            if(name == "rm_species_r")
+                rn_filter_r(st, tmp, removed);
+            else
+                rn_filter_s(st, tmp, removed);
+            std::swap(st, tmp);
+        } else if(name == "write" || name == "sbml") {
+            std::string out=pipeline_arg(cl, arg, "out");
+            if(out.empty()) {
+                std::cout << "No output file given for stage " << name << "!" << std::endl;
+                return 1;
+            }
+
+            size_t threads=cl.have_param("threads") ? cl.get_param_i("threads") : 0;
+            bool net_tools=cl.have_param("sbml_format") && cl.get_param("sbml_format") == "net_tools";
+            int r=(name == "write") ? write_network(out, st) :
+                  (net_tools ? write_sbml_net_tools(out, st) : write_sbml(out, st, threads));
+            if(r) {
+                std::cout << "Error at writing " << out << "!" << std::endl;
+                return 1;
+            }
+        } else if(name == "incidence" || name == "mtx") {
+            std::string out=pipeline_arg(cl, arg, name == "incidence" ? "out" : "mtx");
+            if(out.empty()) {
+                std::cout << "No output file given for stage " << name << "!" << std::endl;
+                return 1;
+            }
+
+            if(name == "incidence" ? write_incidence(out, "", st) : write_incidence("", out, st)) {
+                std::cout << "Error at writing " << out << "!" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cout << "Unknown pipeline stage " << name << "!" << std::endl;
+            return 1;
+        }
+
+        std::cout << " -> " << st.species_count() << " species, " << st.reaction_count() << " reactions" << std::endl;
+    }
+
+    return 0;
+}
+
+
+#endif
@@ -0,0 +1,200 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Optional profiling of the phases of a run (parameter 'profile'): wall
+ * time, cpu time (all threads) and peak resident memory of every phase
+ * (reading, generating, coupling, output, ...) are recorded and written
+ * as JSON at the end of the run. Phases are marked with profile_phase
+ * objects; phases opened while another one is open (e.g. by the workers
+ * of an ensemble) are part of the outer phase and not recorded.
+ */
+
+#ifndef __JRNF_TOOLS_PROFILE_H__
+#define __JRNF_TOOLS_PROFILE_H__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+#include "resource_usage.h"
+
+
+/*
+ * Recorded phases of the run. Phases with the same name are accumulated
+ * (times added, maximum of peak memory).
+ */
+
+class run_profile {
+    struct phase {
+        std::string name;
+        size_t count, peak_kb;
+        double wall, cpu;
+    };
+
+    std::vector<phase> phases;
+    std::atomic<bool> open;
+    bool active;
+
+public:
+    run_profile() : open(false), active(false) {}
+
+    void enable() {  active=true;  }
+    bool enabled() const {  return active;  }
+
+    // Returns true if the calling phase is recorded (no other one is open)
+    bool try_open() {
+        bool expected=false;
+        return active && open.compare_exchange_strong(expected, true);
+    }
+
+    void close(const std::string& name, double wall, double cpu, size_t peak_kb) {
+        size_t i=0;
+        while(i < phases.size() && phases[i].name != name)
+            ++i;
+
+        if(i == phases.size())
+            phases.push_back(phase{name, 0, 0, 0.0, 0.0});
+
+        ++phases[i].count;
+        phases[i].wall += wall;
+        phases[i].cpu += cpu;
+        phases[i].peak_kb=std::max(phases[i].peak_kb, peak_kb);
+        open=false;
+    }
+
+    /*
+     * Writes the JSON summary (run given by `args`, total wall time `wall`)
+     * to `o`.
+     */
+
+    void write_json(std::ostream& o, const std::string& args, double wall) const;
+};
+
+
+inline run_profile& profile() {
+    static run_profile p;
+    return p;
+}
+
+
+inline void append_json_string(std::string& b, const std::string& s) {
+    b.push_back('"');
+    for(size_t i=0; i<s.size(); ++i) {
+        if(s[i] == '"' || s[i] == '\\')
+            b.push_back('\\');
+        if((unsigned char)s[i] >= 0x20)
+            b.push_back(s[i]);
+    }
+    b.push_back('"');
+}
+
+
+inline void run_profile::write_json(std::ostream& o, const std::string& args, double wall) const {
+    std::string a;
+    append_json_string(a, args);
+    size_t peak=current_memory_kb();
+    for(size_t i=0; i<phases.size(); ++i)
+        peak=std::max(peak, phases[i].peak_kb);
+
+    o << "{\"args\": " << a << ", \"wall_s\": " << wall << ", \"cpu_s\": " << cpu_seconds();
+    o << ", \"peak_rss_mb\": " << peak/1024.0 << ", \"phases\": [";
+
+    for(size_t i=0; i<phases.size(); ++i) {
+        std::string n;
+        append_json_string(n, phases[i].name);
+        o << (i == 0 ? "" : ",") << "\n  {\"name\": " << n << ", \"count\": " << phases[i].count;
+        o << ", \"wall_s\": " << phases[i].wall << ", \"cpu_s\": " << phases[i].cpu;
+        o << ", \"peak_rss_mb\": " << phases[i].peak_kb/1024.0 << "}";
+    }
+
+    o << "\n]}" << std::endl;
+}
+
+
+/*
+ * Marks a phase of the run from construction (or next()) to end() / next()
+ * or destruction. Does nothing if profiling isn't enabled.
+ */
+
+class profile_phase {
+    std::string name;
+    bool recording;
+    std::chrono::steady_clock::time_point start;
+    double cpu_start;
+
+public:
+    profile_phase() : recording(false), cpu_start(0) {}
+
+    explicit profile_phase(const std::string& n) : name(n), recording(false), cpu_start(0) {
+        next(n);
+    }
+
+    ~profile_phase() {  end();  }
+
+    void end() {
+        if(!recording)
+            return;
+
+        recording=false;
+        profile().close(name, seconds_since(start), cpu_seconds()-cpu_start, peak_memory_kb());
+    }
+
+    // Ends this phase and starts the phase `n`
+    void next(const std::string& n) {
+        end();
+        name=n;
+        recording=profile().try_open();
+        if(recording) {
+            reset_peak_memory();
+            cpu_start=cpu_seconds();
+            start=std::chrono::steady_clock::now();
+        }
+    }
+};
+
+
+/*
+ * Enables profiling if `file` is given (not null) and writes the summary
+ * on destruction (end of main) to the file `file` or, if it is empty, to
+ * stdout.
+ */
+
+class profile_report {
+    std::string file, args;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    profile_report(const char* f, int argc, const char* argv[]) : active(f != 0),
+                                                                 start(std::chrono::steady_clock::now()) {
+        if(!active)
+            return;
+
+        file=f;
+        for(int i=0; i<argc; ++i)
+            args += (i == 0 ? "" : " ") + std::string(argv[i]);
+        profile().enable();
+    }
+
+    ~profile_report() {
+        if(!active)
+            return;
+
+        if(file.empty()) {
+            profile().write_json(std::cout, args, seconds_since(start));
+            return;
+        }
+
+        std::ofstream out(file.c_str());
+        profile().write_json(out, args, seconds_since(start));
+        if(!out.good())
+            std::cout << "Error at writing profile " << file << "!" << std::endl;
+    }
+};
+
+
+#endif
@@ -0,0 +1,262 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description: 
+ * Macro functions for adding species and reactions of a certain type to
+ * the species and reaction vectors. Used by the network generating modes
+ * of jrnf_tools and by the benchmark program.
+ */
+
+#ifndef __JRNF_TOOLS_REACTION_MACROS_H__
+#define __JRNF_TOOLS_REACTION_MACROS_H__
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <utility>
+
+#include "net_tools/reaction_network.h"
+
+
+/*
+ *  Makro for diffusion connection of two species. (A -> B) reactions 
+ * in both directions with all constants set to 1.0. 
+ *  (The species 'a' and 'b' are connected by adding the respective
+ *   reactions to the reaction vector re.)
+ */
+
+inline void rm_diffusion(std::vector<reaction>& re, size_t a, size_t b) {
+    reaction rea_1;
+	reaction rea_2;
+	
+	rea_1.add_educt(a);
+	rea_1.add_product(b);
+	
+	rea_2.add_educt(b);
+	rea_2.add_product(a);
+	
+	rea_1.set_c(1.0);
+	rea_2.set_c(1.0);
+	rea_1.set_k(1.0);
+	rea_2.set_k(1.0);
+	rea_1.set_k_b(1.0);
+	rea_2.set_k_b(1.0);
+	
+	re.push_back(rea_1);
+	re.push_back(rea_2);
+}
+
+
+/*
+ * Macro for adding a reaction in the form "A ---> B". 
+ * ae - activation energy
+ */
+
+inline void rm_1to1(std::vector<reaction>& re, size_t a, size_t b, double ae=0.0) {
+    reaction rea;
+    rea.set_activation(ae);
+    rea.set_reversible(false);
+    rea.add_educt(a);
+    rea.add_product(b);
+    
+    re.push_back(rea);  
+}
+
+
+/*
+ * Macro for adding a reaction in the form "A <--> B". 
+ * ae - activation energy
+ */
+
+inline void rm_1to1rev(std::vector<reaction>& re, size_t a, size_t b, double ae=0.0) {
+    reaction rea;
+    rea.set_activation(ae);
+    rea.set_reversible(true);
+    rea.add_educt(a);
+    rea.add_product(b);
+    
+    re.push_back(rea);  
+}
+
+
+/*
+ * Macro for adding a reaction in the form "A + B ---> C + D". 
+ * ae - activation energy
+ */
+ 
+inline void rm_2to2(std::vector<reaction>& re, size_t a, size_t b, size_t c, size_t d, double ae=0.0) {
+    reaction rea;
+    rea.set_activation(ae);
+    rea.set_reversible(false);
+    rea.add_educt(a);
+    rea.add_educt(b);
+    rea.add_product(c);
+    rea.add_product(d);
+    
+    re.push_back(rea);  
+}
+
+
+/*
+ * Macro for adding a reaction in the form "A + B <--> C + D". 
+ * ae_dist - distribution of activation energy (drawn with `rng`)
+ * 
+ * TODO unify if set_activation should get relative or absolute energy
+ */
+
+template<typename rng_t>
+void rm_2to2rev(std::vector<reaction>& re, size_t a, size_t b, size_t c, size_t d, size_t ae_dist, rng_t& rng) {
+    reaction rea;
+    rea.set_reversible(true);
+    rea.add_educt(a);
+    rea.add_educt(b);
+    rea.add_product(c);
+    rea.add_product(d);
+    
+    if(ae_dist == 0) {
+        rea.set_activation(rng.uniform());
+    } else {
+        // WARNING Not implemented yet
+	rea.set_activation(rng.uniform());
+    }
+    
+    re.push_back(rea);  
+}
+
+
+/*
+ * Macro for adding a species to the vector `sp`.  Species is named 
+ * "A_<t>", the energy distribution is set by energy_dist (energy is
+ * drawn with the random number generator `rng`, see rng.h)
+ * 
+ * TODO implement different energy distributions
+ */
+
+template<typename rng_t>
+void rm_add_species(std::vector<species>& sp, size_t t, size_t energy_dist, rng_t& rng) {
+    std::stringstream ss;
+    ss << "A_" << t;
+				
+    sp.push_back(species(sp.size(), ss.str(), false, 0));
+    if(energy_dist == 0) {
+        sp.back().set_energy(-rng.uniform());
+    } else {
+        // WARNING Not implemented yet
+	    sp.back().set_energy(rng.uniform());
+    }
+}
+
+
+/*
+ * Macro for adding a species to the vector `sp`.  Species is named 
+ * "A_<t>", the energy is ignored.
+ */
+
+inline void rm_add_species_ne(std::vector<species>& sp, size_t t) {
+    std::stringstream ss;
+    ss << "A_" << t;
+	
+    sp.push_back(species(sp.size(), ss.str(), false, 0));  
+    sp.back().set_energy(0);
+}
+
+
+/*
+ * Macro for adding a species to the vector `sp` without caring about
+ * its energy. species gets name `name` and id is set accordingly.
+ */
+
+inline void rm_add_species_ne(std::vector<species>& sp, const std::string& name) {
+    sp.push_back(species(sp.size(), name, false, 0));
+    sp.back().set_energy(0);
+}
+
+
+/*
+ * The following versions of the macros don't push species / reaction 
+ * objects to vectors but add them to a network sink (`jrnf_writer` from 
+ * jrnf_stream.h or any class with the same add_species / add_reaction 
+ * methods). Rate constants that are not set by the macros are the ones of
+ * a default constructed reaction.
+ */
+
+inline const reaction& rm_default_reaction() {
+    static const reaction def;
+    return def;
+}
+
+
+template<typename sink_t>
+void rm_sink_reaction(sink_t& s, bool reversible, double ae, 
+                      const std::pair<size_t, size_t>* ed, size_t n_ed, 
+                      const std::pair<size_t, size_t>* pr, size_t n_pr) {
+    const reaction& def=rm_default_reaction();
+    s.add_reaction(reversible, def.get_c(), def.get_k(), def.get_k_b(), ae, ed, n_ed, pr, n_pr);
+}
+
+
+template<typename sink_t>
+void rm_1to1(sink_t& s, size_t a, size_t b, double ae=0.0) {
+    std::pair<size_t, size_t> ed(a, 1), pr(b, 1);
+    rm_sink_reaction(s, false, ae, &ed, 1, &pr, 1);
+}
+
+
+template<typename sink_t>
+void rm_1to1rev(sink_t& s, size_t a, size_t b, double ae=0.0) {
+    std::pair<size_t, size_t> ed(a, 1), pr(b, 1);
+    rm_sink_reaction(s, true, ae, &ed, 1, &pr, 1);
+}
+
+
+template<typename sink_t>
+void rm_2to2(sink_t& s, size_t a, size_t b, size_t c, size_t d, double ae=0.0) {
+    std::pair<size_t, size_t> ed[2]={std::make_pair(a, 1), std::make_pair(b, 1)};
+    std::pair<size_t, size_t> pr[2]={std::make_pair(c, 1), std::make_pair(d, 1)};
+    rm_sink_reaction(s, false, ae, ed, 2, pr, 2);
+}
+
+
+template<typename sink_t, typename rng_t>
+void rm_2to2rev(sink_t& s, size_t a, size_t b, size_t c, size_t d, size_t ae_dist, rng_t& rng) {
+    std::pair<size_t, size_t> ed[2]={std::make_pair(a, 1), std::make_pair(b, 1)};
+    std::pair<size_t, size_t> pr[2]={std::make_pair(c, 1), std::make_pair(d, 1)};
+    double ae;
+
+    if(ae_dist == 0) {
+        ae=rng.uniform();
+    } else {
+        // WARNING Not implemented yet
+        ae=rng.uniform();
+    }
+
+    rm_sink_reaction(s, true, ae, ed, 2, pr, 2);
+}
+
+
+template<typename sink_t, typename rng_t>
+void rm_add_species(sink_t& s, size_t t, size_t energy_dist, rng_t& rng) {
+    std::stringstream ss;
+    ss << "A_" << t;
+    
+    if(energy_dist == 0) 
+        s.add_species(ss.str(), false, -rng.uniform());
+    else   // WARNING Not implemented yet
+        s.add_species(ss.str(), false, rng.uniform());
+}
+
+
+template<typename sink_t>
+void rm_add_species_ne(sink_t& s, size_t t) {
+    std::stringstream ss;
+    ss << "A_" << t;
+    s.add_species(ss.str(), false, 0);
+}
+
+
+template<typename sink_t>
+void rm_add_species_ne(sink_t& s, const std::string& name) {
+    s.add_species(name, false, 0);
+}
+
+
+#endif
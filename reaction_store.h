@@ -0,0 +1,186 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Compact container for a reaction network. Instead of species and
+ * reaction objects (with two small vectors per reaction) all properties
+ * are kept in flat columns and the stoichiometry in CSR form: the educts
+ * and products of reaction i are the entries [st_off[i], st_off[i+1]) of
+ * `stoich` with the n_educts[i] educts first.
+ *
+ * rn_store is a network sink (see network_sink.h), so the rm_* macros and
+ * the readers can fill it directly, and it can be given to any other sink
+ * with emit(). to_vectors / rn_store_from_vectors convert to and from the
+ * species and reaction vectors of net_tools.
+ */
+
+#ifndef __JRNF_TOOLS_REACTION_STORE_H__
+#define __JRNF_TOOLS_REACTION_STORE_H__
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+
+#include "net_tools/reaction_network.h"
+#include "network_sink.h"
+
+
+class rn_store {
+public:
+    // species columns (names concatenated, name i is [name_off[i], name_off[i+1]))
+    std::string names;
+    std::vector<size_t> name_off;
+    std::vector<uint8_t> constant;
+    std::vector<double> energy;
+
+    // reaction columns
+    std::vector<uint8_t> reversible;
+    std::vector<double> c, k, k_b, activation;
+    std::vector<size_t> st_off, n_educts;
+    std::vector< std::pair<size_t, size_t> > stoich;    // (species id, multiplicity)
+
+    rn_store() : name_off(1, 0), st_off(1, 0) {}
+
+    void clear() {
+        *this=rn_store();
+    }
+
+    size_t species_count() const {  return energy.size();  }
+    size_t reaction_count() const {  return c.size();  }
+
+    std::string species_name(size_t i) const {
+        return names.substr(name_off[i], name_off[i+1]-name_off[i]);
+    }
+
+    const std::pair<size_t, size_t>* educts(size_t i) const {  return stoich.data()+st_off[i];  }
+    size_t educt_count(size_t i) const {  return n_educts[i];  }
+    const std::pair<size_t, size_t>* products(size_t i) const {  return stoich.data()+st_off[i]+n_educts[i];  }
+    size_t product_count(size_t i) const {  return st_off[i+1]-st_off[i]-n_educts[i];  }
+
+
+    /*
+     * Network sink interface
+     */
+
+    void reserve(size_t sp_count, size_t re_count) {
+        name_off.reserve(name_off.size()+sp_count);
+        constant.reserve(constant.size()+sp_count);
+        energy.reserve(energy.size()+sp_count);
+
+        reversible.reserve(reversible.size()+re_count);
+        c.reserve(c.size()+re_count);
+        k.reserve(k.size()+re_count);
+        k_b.reserve(k_b.size()+re_count);
+        activation.reserve(activation.size()+re_count);
+        st_off.reserve(st_off.size()+re_count);
+        n_educts.reserve(n_educts.size()+re_count);
+    }
+
+    void add_species(const std::string& name, bool con, double en) {
+        names.append(name);
+        name_off.push_back(names.size());
+        constant.push_back(con);
+        energy.push_back(en);
+    }
+
+    void add_species(const species& s) {
+        add_species(s.get_name(), s.is_constant(), s.get_energy());
+    }
+
+    void add_reaction(bool rev, double c_, double k_, double k_b_, double act,
+                      const std::pair<size_t, size_t>* ed, size_t n_ed,
+                      const std::pair<size_t, size_t>* pr, size_t n_pr) {
+        reversible.push_back(rev);
+        c.push_back(c_);
+        k.push_back(k_);
+        k_b.push_back(k_b_);
+        activation.push_back(act);
+        n_educts.push_back(n_ed);
+        stoich.insert(stoich.end(), ed, ed+n_ed);
+        stoich.insert(stoich.end(), pr, pr+n_pr);
+        st_off.push_back(stoich.size());
+    }
+
+    void add_reaction(const reaction& r) {
+        const std::vector< std::pair<size_t, size_t> >& ed=r.get_educts();
+        const std::vector< std::pair<size_t, size_t> >& pr=r.get_products();
+        add_reaction(r.is_reversible(), r.get_c(), r.get_k(), r.get_k_b(), r.get_activation(),
+                     ed.data(), ed.size(), pr.data(), pr.size());
+    }
+
+
+    /*
+     * Appends all reactions of `o` (species ids are kept as they are).
+     */
+
+    void append_reactions(const rn_store& o) {
+        reversible.insert(reversible.end(), o.reversible.begin(), o.reversible.end());
+        c.insert(c.end(), o.c.begin(), o.c.end());
+        k.insert(k.end(), o.k.begin(), o.k.end());
+        k_b.insert(k_b.end(), o.k_b.begin(), o.k_b.end());
+        activation.insert(activation.end(), o.activation.begin(), o.activation.end());
+        n_educts.insert(n_educts.end(), o.n_educts.begin(), o.n_educts.end());
+
+        size_t off=stoich.size();
+        stoich.insert(stoich.end(), o.stoich.begin(), o.stoich.end());
+        for(size_t i=1; i<o.st_off.size(); ++i)
+            st_off.push_back(off+o.st_off[i]);
+    }
+
+
+    /*
+     * Adds species `i` / reaction `i` / the whole network to the sink `s`.
+     */
+
+    template<typename sink_t>
+    void emit_species(sink_t& s, size_t i) const {
+        s.add_species(species_name(i), constant[i] != 0, energy[i]);
+    }
+
+    template<typename sink_t>
+    void emit_reaction(sink_t& s, size_t i) const {
+        s.add_reaction(reversible[i] != 0, c[i], k[i], k_b[i], activation[i],
+                       educts(i), educt_count(i), products(i), product_count(i));
+    }
+
+    template<typename sink_t>
+    void emit(sink_t& s) const {
+        s.reserve(species_count(), reaction_count());
+
+        for(size_t i=0; i<species_count(); ++i)
+            emit_species(s, i);
+
+        for(size_t i=0; i<reaction_count(); ++i)
+            emit_reaction(s, i);
+    }
+
+
+    /*
+     * Appends the network to the vectors `sp` and `re` (conversion for code
+     * working with species and reaction objects).
+     */
+
+    void to_vectors(std::vector<species>& sp, std::vector<reaction>& re) const {
+        rn_vector_sink s(sp, re);
+        emit(s);
+    }
+};
+
+
+/*
+ * Fills `st` with the network given by the vectors `sp` and `re`.
+ */
+
+inline void rn_store_from_vectors(rn_store& st, const std::vector<species>& sp, const std::vector<reaction>& re) {
+    st.clear();
+    st.reserve(sp.size(), re.size());
+
+    for(size_t i=0; i<sp.size(); ++i)
+        st.add_species(sp[i]);
+
+    for(size_t i=0; i<re.size(); ++i)
+        st.add_reaction(re[i]);
+}
+
+
+#endif
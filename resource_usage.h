@@ -0,0 +1,98 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Wall time, cpu time and memory usage of the process (for benchmarks and
+ * profiling). Memory is read from /proc/self/status (Linux); where this
+ * isn't available the peak is taken from getrusage and can't be reset.
+ */
+
+#ifndef __JRNF_TOOLS_RESOURCE_USAGE_H__
+#define __JRNF_TOOLS_RESOURCE_USAGE_H__
+
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <sys/resource.h>
+
+
+/*
+ * Returns seconds passed since `start`.
+ */
+
+inline double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+
+/*
+ * Cpu time (user + system, all threads) used by the process in seconds.
+ */
+
+inline double cpu_seconds() {
+    rusage u;
+    if(getrusage(RUSAGE_SELF, &u) != 0)
+        return 0.0;
+
+    return double(u.ru_utime.tv_sec+u.ru_stime.tv_sec) + 1e-6*double(u.ru_utime.tv_usec+u.ru_stime.tv_usec);
+}
+
+
+/*
+ * Returns the value (kB) of the line `key` ("VmRSS:", "VmHWM:") of
+ * /proc/self/status, 0 if not available.
+ */
+
+inline size_t proc_status_kb(const char* key) {
+    std::ifstream in("/proc/self/status");
+    std::string k;
+    size_t v;
+
+    while(in >> k) {
+        if(k == key && in >> v)
+            return v;
+        std::getline(in, k);
+    }
+
+    return 0;
+}
+
+
+/*
+ * Current resident memory of the process in kB.
+ */
+
+inline size_t current_memory_kb() {
+    return proc_status_kb("VmRSS:");
+}
+
+
+/*
+ * Peak resident memory of the process (since start or the last call to
+ * reset_peak_memory) in kB.
+ */
+
+inline size_t peak_memory_kb() {
+    size_t hwm=proc_status_kb("VmHWM:");
+    if(hwm != 0)
+        return hwm;
+
+    rusage u;
+    return getrusage(RUSAGE_SELF, &u) == 0 ? size_t(u.ru_maxrss) : 0;
+}
+
+
+/*
+ * Resets the peak resident memory to the current one, so the memory used
+ * by a phase can be measured. Returns false if this is not supported.
+ */
+
+inline bool reset_peak_memory() {
+    std::ofstream out("/proc/self/clear_refs");
+    out << "5" << std::endl;
+    return out.good();
+}
+
+
+#endif
@@ -0,0 +1,114 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Small and fast pseudo random number generator (xoshiro256**, seeded by
+ * splitmix64) replacing rand(). Every generator is determined by a seed and
+ * a stream number, so independent generators for parallel generation can
+ * be derived deterministically from one seed.
+ */
+
+#ifndef __JRNF_TOOLS_RNG_H__
+#define __JRNF_TOOLS_RNG_H__
+
+#include <cstdint>
+#include <cstddef>
+
+
+/*
+ * splitmix64 step, used for seeding and for mixing seeds.
+ */
+
+inline uint64_t splitmix64(uint64_t& x) {
+    uint64_t z=(x += 0x9e3779b97f4a7c15ULL);
+    z=(z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z=(z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+
+class rn_rng {
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) {  return (x << k) | (x >> (64-k));  }
+
+public:
+    typedef uint64_t result_type;
+
+    rn_rng(uint64_t seed=0, uint64_t stream=0) {
+        this->seed(seed, stream);
+    }
+
+
+    /*
+     * (Re)initializes the generator for `seed` and stream number `stream`.
+     */
+
+    void seed(uint64_t seed, uint64_t stream=0) {
+        uint64_t x=seed;
+        uint64_t mix=splitmix64(x) ^ stream;
+        x=mix;
+        splitmix64(x);     // decorrelate neighbouring streams
+        for(size_t i=0; i<4; ++i)
+            s[i]=splitmix64(x);
+    }
+
+
+    /*
+     * Returns a generator for stream `stream` derived from the current state
+     * (doesn't change this generator).
+     */
+
+    rn_rng split(uint64_t stream) const {
+        return rn_rng(s[0] ^ rotl(s[1], 17) ^ rotl(s[2], 31) ^ rotl(s[3], 47), stream);
+    }
+
+    uint64_t operator()() {
+        uint64_t r=rotl(s[1]*5, 7)*9;
+        uint64_t t=s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3]=rotl(s[3], 45);
+
+        return r;
+    }
+
+    static constexpr uint64_t min() {  return 0;  }
+    static constexpr uint64_t max() {  return ~uint64_t(0);  }
+
+
+    /*
+     * Uniformly distributed double from [0, 1).
+     */
+
+    double uniform() {
+        return double((*this)() >> 11) * (1.0/9007199254740992.0);
+    }
+
+
+    /*
+     * Uniformly distributed integer from [0, n) (n > 0), using Lemire's
+     * multiply and reject method.
+     */
+
+    uint64_t below(uint64_t n) {
+        unsigned __int128 m=(unsigned __int128)(*this)() * n;
+        uint64_t l=uint64_t(m);
+
+        if(l < n) {
+            uint64_t t=(0-n) % n;
+            while(l < t) {
+                m=(unsigned __int128)(*this)() * n;
+                l=uint64_t(m);
+            }
+        }
+
+        return uint64_t(m >> 64);
+    }
+};
+
+
+#endif
@@ -0,0 +1,307 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * SBML output in the format of write_sbml_reaction_n of net_tools (SBML
+ * level 2: species with their constant flag as boundary condition,
+ * reactions with reactants, products and the rate constants k / k_b as
+ * parameters; energies, c and activation energies aren't written).
+ *
+ * The document can be written from a rn_store (formatting species and
+ * reactions in parallel) or streamed with sbml_writer, which is a network
+ * sink (see network_sink.h). Both give identical files for any number of
+ * threads, files named "*.gz" are gzip compressed (see compressed_file.h).
+ * 'jrnf_bench sbml_parity' compares them byte for byte with each other and
+ * with write_sbml_reaction_n (write_sbml_net_tools, 'sbml_format=net_tools'),
+ * it has to pass before the format here is changed.
+ */
+
+#ifndef __JRNF_TOOLS_SBML_WRITER_H__
+#define __JRNF_TOOLS_SBML_WRITER_H__
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#include "net_tools/reaction_network.h"
+#include "net_tools/reaction_network_fileop.h"
+#include "reaction_store.h"
+#include "thread_pool.h"
+#include "number_format.h"
+#include "compressed_file.h"
+
+
+/*
+ * Helper functions appending to the output buffer `b`. Floating point
+ * numbers are written as by iostreams (6 significant digits, "%g") as
+ * write_sbml_reaction_n does, unless another precision is selected.
+ */
+
+inline void sbml_append(std::string& b, size_t v) {
+    append_number(b, v);
+}
+
+inline void sbml_append(std::string& b, double v) {
+    append_number(b, v, output_precision() == 0 ? 6 : output_precision());
+}
+
+inline void sbml_append_escaped(std::string& b, const char* s, size_t n) {
+    for(size_t i=0; i<n; ++i)
+        switch(s[i]) {
+            case '&':  b.append("&amp;");  break;
+            case '<':  b.append("&lt;");  break;
+            case '>':  b.append("&gt;");  break;
+            case '"':  b.append("&quot;");  break;
+            default:   b.push_back(s[i]);
+        }
+}
+
+
+inline void sbml_append_species_refs(std::string& b, const char* list,
+                                     const std::pair<size_t, size_t>* s, size_t n) {
+    b.append("        <");
+    b.append(list);
+    b.append(">\n");
+
+    for(size_t i=0; i<n; ++i) {
+        b.append("          <speciesReference species=\"s");
+        sbml_append(b, s[i].first);
+        b.append("\" stoichiometry=\"");
+        sbml_append(b, s[i].second);
+        b.append("\"/>\n");
+    }
+
+    b.append("        </");
+    b.append(list);
+    b.append(">\n");
+}
+
+
+/*
+ * Appends the SBML description of species number `i` (name [name, 
+ * name+n)) to `b`.
+ */
+
+inline void sbml_append_species(std::string& b, size_t i, const char* name, size_t n, bool con, double) {
+    b.append("      <species id=\"s");
+    sbml_append(b, i);
+    b.append("\" name=\"");
+    sbml_append_escaped(b, name, n);
+    b.append("\" compartment=\"compartment\" initialConcentration=\"1\" boundaryCondition=\"");
+    b.append(con ? "true" : "false");
+    b.append("\"/>\n");
+}
+
+inline void sbml_append_species(std::string& b, const rn_store& st, size_t i) {
+    size_t nb=st.name_off[i];
+    sbml_append_species(b, i, st.names.data()+nb, st.name_off[i+1]-nb, st.constant[i] != 0, st.energy[i]);
+}
+
+
+/*
+ * Appends the SBML description of reaction number `i` to `b`.
+ */
+
+inline void sbml_append_reaction(std::string& b, size_t i, bool rev, double, double k, double k_b, double,
+                                 const std::pair<size_t, size_t>* ed, size_t n_ed,
+                                 const std::pair<size_t, size_t>* pr, size_t n_pr) {
+    b.append("      <reaction id=\"r");
+    sbml_append(b, i);
+    b.append("\" reversible=\"");
+    b.append(rev ? "true" : "false");
+    b.append("\">\n");
+
+    sbml_append_species_refs(b, "listOfReactants", ed, n_ed);
+    sbml_append_species_refs(b, "listOfProducts", pr, n_pr);
+
+    b.append("        <kineticLaw>\n");
+    b.append("          <listOfParameters>\n");
+    b.append("            <parameter id=\"k\" value=\"");
+    sbml_append(b, k);
+    b.append("\"/>\n");
+    if(rev) {
+        b.append("            <parameter id=\"k_b\" value=\"");
+        sbml_append(b, k_b);
+        b.append("\"/>\n");
+    }
+    b.append("          </listOfParameters>\n");
+    b.append("        </kineticLaw>\n");
+    b.append("      </reaction>\n");
+}
+
+inline void sbml_append_reaction(std::string& b, const rn_store& st, size_t i) {
+    sbml_append_reaction(b, i, st.reversible[i] != 0, st.c[i], st.k[i], st.k_b[i], st.activation[i],
+                         st.educts(i), st.educt_count(i), st.products(i), st.product_count(i));
+}
+
+
+/*
+ * Parts of the document before the species, between species and reactions
+ * and after the reactions.
+ */
+
+inline const char* sbml_head() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<sbml xmlns=\"http://www.sbml.org/sbml/level2\" level=\"2\" version=\"1\">\n"
+           "  <model name=\"reaction_network\">\n"
+           "    <listOfCompartments>\n"
+           "      <compartment id=\"compartment\" size=\"1\"/>\n"
+           "    </listOfCompartments>\n"
+           "    <listOfSpecies>\n";
+}
+
+inline const char* sbml_middle() {
+    return "    </listOfSpecies>\n"
+           "    <listOfReactions>\n";
+}
+
+inline const char* sbml_tail() {
+    return "    </listOfReactions>\n"
+           "  </model>\n"
+           "</sbml>\n";
+}
+
+
+/*
+ * Formats the elements [0, n) with `append(b, i)` on `threads` threads and
+ * writes them in order to `out`. Elements are formatted in chunks into 
+ * one buffer per chunk; only one round of chunks (a few per thread) is 
+ * held in memory at a time.
+ */
+
+template<typename append_t>
+void sbml_write_parallel(output_file& out, size_t n, size_t threads, append_t append) {
+    const size_t chunk=1024;
+    threads=thread_count(threads);
+
+    std::vector<std::string> bufs(4*threads);
+    for(size_t b=0; b<n; b+=chunk*bufs.size()) {
+        size_t chunks=std::min(bufs.size(), (n-b+chunk-1)/chunk);
+
+        parallel_for(chunks, threads, [&](size_t j) {
+            bufs[j].clear();
+            size_t e=std::min(n, b+(j+1)*chunk);
+            for(size_t i=b+j*chunk; i<e; ++i)
+                append(bufs[j], i);
+        });
+
+        for(size_t j=0; j<chunks; ++j)
+            out.write(bufs[j].data(), bufs[j].size());
+    }
+}
+
+
+/*
+ * Writes the network `st` to the SBML file `filename`, species and 
+ * reactions are formatted on `threads` threads (0 - all cores). Returns 0
+ * on success.
+ */
+
+inline int write_sbml(const std::string& filename, const rn_store& st, size_t threads=0) {
+    output_file out;
+    if(!out.open(filename, threads))
+        return 1;
+
+    out.write(sbml_head());
+    sbml_write_parallel(out, st.species_count(), threads, 
+                        [&](std::string& b, size_t i) {  sbml_append_species(b, st, i);  });
+    out.write(sbml_middle());
+    sbml_write_parallel(out, st.reaction_count(), threads, 
+                        [&](std::string& b, size_t i) {  sbml_append_reaction(b, st, i);  });
+    out.write(sbml_tail());
+
+    return out.close() ? 0 : 1;
+}
+
+
+/*
+ * Network sink writing SBML while the network is generated or read. Only
+ * a small buffer is held in memory. All species have to be added before 
+ * the first reaction.
+ */
+
+class sbml_writer {
+    output_file out;
+    std::string b;
+    size_t sp_count, re_count;
+
+    void flush() {
+        if(b.size() > (1 << 20)) {
+            out.write(b.data(), b.size());
+            b.clear();
+        }
+    }
+
+public:
+    sbml_writer() : sp_count(0), re_count(0) {}
+
+    bool open(const std::string& filename) {
+        b.assign(sbml_head());
+        sp_count=re_count=0;
+        return out.open(filename, io_threads());
+    }
+
+    void reserve(size_t, size_t) {}
+
+    void add_species(const std::string& name, bool con, double en) {
+        sbml_append_species(b, sp_count++, name.data(), name.size(), con, en);
+        flush();
+    }
+
+    void add_reaction(bool rev, double c, double k, double k_b, double act,
+                      const std::pair<size_t, size_t>* ed, size_t n_ed,
+                      const std::pair<size_t, size_t>* pr, size_t n_pr) {
+        if(re_count == 0)
+            b.append(sbml_middle());
+
+        sbml_append_reaction(b, re_count++, rev, c, k, k_b, act, ed, n_ed, pr, n_pr);
+        flush();
+    }
+
+    bool close() {
+        if(re_count == 0)
+            b.append(sbml_middle());
+
+        b.append(sbml_tail());
+        out.write(b.data(), b.size());
+        b.clear();
+        return out.close();
+    }
+};
+
+
+
+/*
+ * Writes the network `sp` / `re` with write_sbml_reaction_n of net_tools
+ * (the reference for the format, see sbml_parity of jrnf_bench). It
+ * writes uncompressed files only, so names "*.gz" are rejected. As net_tools
+ * doesn't report errors the file has to be writable before and not empty
+ * after writing. Returns 0 on success.
+ */
+
+inline int write_sbml_net_tools(const std::string& filename, const std::vector<species>& sp,
+                                const std::vector<reaction>& re) {
+    if(is_gz_filename(filename)) {
+        std::cout << "sbml_format=net_tools can't write compressed files (" << filename << ")!" << std::endl;
+        return 1;
+    }
+
+    if(!std::ofstream(filename.c_str(), std::ios::out | std::ios::trunc).is_open())
+        return 1;
+
+    write_sbml_reaction_n(filename, sp, re);
+
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    return (in.is_open() && in.tellg() > 0) ? 0 : 1;
+}
+
+inline int write_sbml_net_tools(const std::string& filename, const rn_store& st) {
+    std::vector<species> sp;
+    std::vector<reaction> re;
+    st.to_vectors(sp, re);
+    return write_sbml_net_tools(filename, sp, re);
+}
+
+
+#endif
@@ -0,0 +1,127 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Hash index from species names to species ids of a rn_store. Open
+ * addressing with linear probing; the table holds only ids, names are
+ * compared against the name block of the store.
+ */
+
+#ifndef __JRNF_TOOLS_SPECIES_INDEX_H__
+#define __JRNF_TOOLS_SPECIES_INDEX_H__
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#include "reaction_store.h"
+
+
+class species_index {
+    const rn_store& st;
+    std::vector<size_t> slots;      // species id + 1, 0 marks an empty slot
+    size_t mask, count;
+    bool unique_names;
+
+    static uint64_t hash(const char* s, size_t n) {
+        uint64_t h=0xcbf29ce484222325ULL;       // FNV-1a ...
+        for(size_t i=0; i<n; ++i)
+            h=(h ^ uint8_t(s[i])) * 0x100000001b3ULL;
+
+        h ^= h >> 32;                           // ... with some final mixing
+        h *= 0xd6e8feb86659fd93ULL;
+        return h ^ (h >> 32);
+    }
+
+    bool equals(size_t id, const char* s, size_t n) const {
+        size_t b=st.name_off[id], e=st.name_off[id+1];
+        return e-b == n && std::memcmp(st.names.data()+b, s, n) == 0;
+    }
+
+    size_t find_slot(const char* s, size_t n) const {
+        size_t i=hash(s, n) & mask;
+        while(slots[i] != 0 && !equals(slots[i]-1, s, n))
+            i=(i+1) & mask;
+        return i;
+    }
+
+    void rehash(size_t size) {
+        std::vector<size_t> old;
+        old.swap(slots);
+        slots.assign(size, 0);
+        mask=size-1;
+
+        for(size_t i=0; i<old.size(); ++i)
+            if(old[i] != 0) {
+                size_t id=old[i]-1;
+                size_t b=st.name_off[id];
+                slots[find_slot(st.names.data()+b, st.name_off[id+1]-b)]=old[i];
+            }
+    }
+
+public:
+    static constexpr size_t npos=size_t(-1);
+
+
+    /*
+     * Creates the index of all species of `s` (the store has to live as
+     * long as the index). If names occur more than once the first id is
+     * found (see unique).
+     */
+
+    species_index(const rn_store& s) : st(s), count(0), unique_names(true) {
+        size_t size=16;
+        while(size < 2*st.species_count())
+            size *= 2;
+
+        slots.assign(size, 0);
+        mask=size-1;
+
+        for(size_t i=0; i<st.species_count(); ++i)
+            insert(i);
+    }
+
+
+    /*
+     * Adds species `id` of the store (after it was added to the store).
+     */
+
+    void insert(size_t id) {
+        if(2*(count+1) > slots.size())
+            rehash(2*slots.size());
+
+        size_t b=st.name_off[id];
+        size_t i=find_slot(st.names.data()+b, st.name_off[id+1]-b);
+        if(slots[i] == 0) {
+            slots[i]=id+1;
+            ++count;
+        } else
+            unique_names=false;
+    }
+
+
+    /*
+     * Returns false if a name was added more than once.
+     */
+
+    bool unique() const {
+        return unique_names;
+    }
+
+
+    /*
+     * Returns the id of the species with name `name` or npos.
+     */
+
+    size_t find(const char* name, size_t n) const {
+        size_t i=find_slot(name, n);
+        return slots[i] == 0 ? npos : slots[i]-1;
+    }
+
+    size_t find(const std::string& name) const {
+        return find(name.data(), name.size());
+    }
+};
+
+
+#endif
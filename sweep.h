@@ -0,0 +1,258 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Parameter sweeps for the create_* modes. For every parameter (N, M, C,
+ * alpha, h, m, r) a list of values is given, all combinations of them are
+ * generated in one process on a work stealing pool and a manifest listing
+ * every output file with its parameters, seed and runtime is written.
+ *
+ * Values are given on the command line (e.g. "N=100:1000:100 M=200,400")
+ * and / or in a grid file ('grid=<file>') with one line "<parameter>
+ * <values>" per parameter; the grid file wins for parameters given in
+ * both. Values are a single number, a comma separated list or an inclusive
+ * range "<from>:<to>:<step>". N, M, C, h and m can't be negative.
+ */
+
+#ifndef __JRNF_TOOLS_SWEEP_H__
+#define __JRNF_TOOLS_SWEEP_H__
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+#include "tools/cl_para.h"
+#include "create_modes.h"
+#include "thread_pool.h"
+
+
+/*
+ * Parses a value specification (see above) into `values`. Returns false if
+ * the specification is broken.
+ */
+
+inline bool parse_sweep_values(const std::string& spec, std::vector<double>& values) {
+    values.clear();
+
+    if(spec.find(':') != std::string::npos) {
+        double from, to, step;
+        char c1, c2;
+        std::stringstream ss(spec);
+        if(!(ss >> from >> c1 >> to >> c2 >> step) || c1 != ':' || c2 != ':' || step <= 0)
+            return false;
+        if(!(ss >> std::ws).eof())      // trailing characters
+            return false;
+
+        // small tolerance so that the end point is included for fractional steps
+        for(size_t i=0; from+i*step <= to+1e-9*step; ++i)
+            values.push_back(from+i*step);
+        return !values.empty();
+    }
+
+    std::stringstream ss(spec);
+    std::string v;
+    while(std::getline(ss, v, ',')) {
+        char* end;
+        values.push_back(strtod(v.c_str(), &end));
+        if(v.empty() || *end != 0)
+            return false;
+    }
+
+    return !values.empty();
+}
+
+
+/*
+ * Returns true if parameter `name` is an integer (a count).
+ */
+
+inline bool sweep_integer_parameter(const std::string& name) {
+    return name == "N" || name == "M" || name == "C" || name == "h" || name == "m";
+}
+
+
+/*
+ * Sets parameter `name` of `p` to `v` (not negative for integer parameters).
+ */
+
+inline void set_sweep_value(create_para& p, const std::string& name, double v) {
+    size_t i=size_t(v+0.5);
+
+    if(name == "N")           p.N=i;
+    else if(name == "M")      p.M=i;
+    else if(name == "C")      p.C=i;
+    else if(name == "alpha")  p.alpha=v;
+    else if(name == "h")      p.h=i;
+    else if(name == "m")      p.m=i;
+    else if(name == "r")      p.r=v;
+}
+
+
+/*
+ * Names of the parameters used by the mode of `p`.
+ */
+
+inline std::vector<std::string> sweep_parameters(const create_para& p) {
+    std::vector<std::string> names={"N", "M"};
+
+    if(p.is_coupled())
+        names.push_back("C");
+    if(p.uses_alpha())
+        names.push_back("alpha");
+    if(p.uses_h())
+        names.push_back("h");
+    if(p.uses_mr()) {
+        names.push_back("m");
+        names.push_back("r");
+    }
+
+    return names;
+}
+
+
+/*
+ * Result of a single generated network of a sweep.
+ */
+
+struct sweep_job {
+    create_para p;
+    uint64_t seed;
+    std::string out;
+    double seconds;
+    int status;
+};
+
+
+/*
+ * Runs the sweep for the create mode `base.mode` (parameters not swept are 
+ * taken from `base`). Every grid point is generated 'ensemble' times (default
+ * once), job i gets seed <seed>+i and is written to `out` numbered with i.
+ * The manifest is written to 'manifest' (default: <out>.manifest). Returns 0
+ * if all networks were written.
+ */
+
+inline int run_sweep(cl_para& cl, const create_para& base, const std::string& out, uint64_t seed) {
+    // Value lists from the grid file and the command line
+    std::map<std::string, std::string> specs;
+    std::vector<std::string> names=sweep_parameters(base);
+
+    if(cl.have_param("grid")) {
+        std::ifstream in(cl.get_param("grid").c_str());
+        if(!in.is_open()) {
+            std::cout << "Could not open grid file " << cl.get_param("grid") << "!" << std::endl;
+            return 1;
+        }
+
+        std::string line;
+        while(std::getline(in, line)) {
+            std::stringstream ss(line);
+            std::string name, spec;
+            if((ss >> name >> spec) && name[0] != '#')
+                specs[name]=spec;
+        }
+    }
+
+    // parameters not in the grid file are taken from the command line
+    for(size_t i=0; i<names.size(); ++i)
+        if(specs.count(names[i]) == 0 && cl.have_param(names[i]))
+            specs[names[i]]=cl.get_param(names[i]);
+
+    std::vector< std::vector<double> > values(names.size());
+    size_t points=1;
+    for(size_t i=0; i<names.size(); ++i) {
+        if(specs.count(names[i]) == 0) {
+            std::cout << "No values given for parameter " << names[i] << "!" << std::endl;
+            return 1;
+        }
+
+        if(!parse_sweep_values(specs[names[i]], values[i])) {
+            std::cout << "Could not parse values '" << specs[names[i]] << "' of " << names[i] << "!" << std::endl;
+            return 1;
+        }
+
+        for(size_t j=0; j<values[i].size(); ++j)
+            if(sweep_integer_parameter(names[i]) && values[i][j] < 0) {
+                std::cout << "Negative value " << values[i][j] << " of " << names[i] << "!" << std::endl;
+                return 1;
+            }
+
+        points *= values[i].size();
+    }
+
+    // All combinations (last parameter changing fastest) times repetitions
+    size_t repeat=cl.have_param("ensemble") ? cl.get_param_i("ensemble") : 1;
+    std::vector<sweep_job> jobs(points*repeat);
+
+    for(size_t pt=0; pt<points; ++pt) {
+        create_para p=base;
+        for(size_t i=names.size(), rest=pt; i-- > 0; rest /= values[i].size())
+            set_sweep_value(p, names[i], values[i][rest % values[i].size()]);
+
+        for(size_t j=0; j<repeat; ++j) {
+            sweep_job& job=jobs[pt*repeat+j];
+            job.p=p;
+            job.seed=seed+pt*repeat+j;
+            job.out=ensemble_filename(out, pt*repeat+j, jobs.size());
+            job.seconds=0;
+            job.status=-1;
+        }
+    }
+
+    task_pool pool(cl.have_param("threads") ? cl.get_param_i("threads") : 0);
+    std::cout << "sweep of " << points << " parameter combinations x " << repeat;
+    std::cout << " networks on " << pool.size() << " threads" << std::endl;
+    if(!base.fast)
+        std::cout << "generator=net_tools: networks are generated one at a time!" << std::endl;
+
+    for(size_t i=0; i<jobs.size(); ++i)
+        pool.submit([&jobs, i]() {
+            sweep_job& job=jobs[i];
+            std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+            job.status=create_network_file(job.p, job.seed, job.out, false);
+            job.seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+        });
+
+    std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+    pool.run();
+    double total=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+    // Manifest (tab separated, one line per network)
+    std::string manifest=cl.have_param("manifest") ? cl.get_param("manifest") : out+".manifest";
+    std::ofstream mf(manifest.c_str());
+    size_t failed=0;
+
+    mf << "file\tmode";
+    for(size_t i=0; i<names.size(); ++i)
+        mf << "\t" << names[i];
+    mf << "\tseed\tseconds\tstatus\n";
+
+    for(size_t i=0; i<jobs.size(); ++i) {
+        const create_para& p=jobs[i].p;
+        mf << jobs[i].out << "\t" << p.mode << "\t" << p.N << "\t" << p.M;
+        if(p.is_coupled())
+            mf << "\t" << p.C;
+        if(p.uses_alpha())
+            mf << "\t" << p.alpha;
+        if(p.uses_h())
+            mf << "\t" << p.h;
+        if(p.uses_mr())
+            mf << "\t" << p.m << "\t" << p.r;
+        mf << "\t" << jobs[i].seed << "\t" << jobs[i].seconds << "\t" << (jobs[i].status == 0 ? "ok" : "error") << "\n";
+
+        if(jobs[i].status != 0)
+            ++failed;
+    }
+
+    std::cout << "generated " << jobs.size()-failed << " of " << jobs.size() << " networks in ";
+    std::cout << total << " s, manifest written to " << manifest << std::endl;
+
+    return (failed == 0 && mf.good()) ? 0 : 1;
+}
+
+
+#endif
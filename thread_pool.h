@@ -0,0 +1,151 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Minimal helpers for running independent jobs on several threads.
+ */
+
+#ifndef __JRNF_TOOLS_THREAD_POOL_H__
+#define __JRNF_TOOLS_THREAD_POOL_H__
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+
+/*
+ * Returns the number of threads to use if `requested` is 0 (all cores),
+ * otherwise `requested`.
+ */
+
+inline size_t thread_count(size_t requested) {
+    if(requested != 0)
+        return requested;
+
+    size_t hc=std::thread::hardware_concurrency();
+    return hc == 0 ? 1 : hc;
+}
+
+
+/*
+ * Number of threads used for parsing large jrnf files and compressing
+ * output files (0 - all cores). Set once (parameter 'threads') before any
+ * file is read or written.
+ */
+
+inline size_t& io_threads() {
+    static size_t t=0;
+    return t;
+}
+
+
+/*
+ * Calls f(i) for all i in [0, n) on `threads` threads. Jobs are handed out
+ * one by one (atomic counter), so jobs of different length are balanced.
+ * Returns after all jobs have finished.
+ */
+
+template<typename func_t>
+void parallel_for(size_t n, size_t threads, func_t f) {
+    threads=thread_count(threads);
+    if(threads > n)
+        threads=n;
+
+    if(threads <= 1) {
+        for(size_t i=0; i<n; ++i)
+            f(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+
+    for(size_t t=0; t<threads; ++t)
+        workers.push_back(std::thread([&]() {
+            for(size_t i=next++; i<n; i=next++)
+                f(i);
+        }));
+
+    for(size_t t=0; t<workers.size(); ++t)
+        workers[t].join();
+}
+
+
+/*
+ * Work stealing pool for a fixed set of tasks. Tasks are distributed round
+ * robin over one queue per thread. Every thread works on its own queue 
+ * from the back and, when it is empty, steals from the front of the 
+ * others. run() returns after all tasks have been executed. (Tasks may not
+ * submit new tasks.)
+ */
+
+class task_pool {
+    struct task_queue {
+        std::mutex m;
+        std::deque< std::function<void()> > q;
+    };
+
+    std::vector< std::unique_ptr<task_queue> > queues;
+    size_t next_queue;
+
+    bool pop_own(size_t t, std::function<void()>& f) {
+        std::lock_guard<std::mutex> lock(queues[t]->m);
+        if(queues[t]->q.empty())
+            return false;
+
+        f=std::move(queues[t]->q.back());
+        queues[t]->q.pop_back();
+        return true;
+    }
+
+    bool steal(size_t t, std::function<void()>& f) {
+        for(size_t i=1; i<queues.size(); ++i) {
+            task_queue& v=*queues[(t+i) % queues.size()];
+            std::lock_guard<std::mutex> lock(v.m);
+            if(!v.q.empty()) {
+                f=std::move(v.q.front());
+                v.q.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t t) {
+        std::function<void()> f;
+        while(pop_own(t, f) || steal(t, f))
+            f();
+    }
+
+public:
+    task_pool(size_t threads) : next_queue(0) {
+        threads=thread_count(threads);
+        for(size_t t=0; t<threads; ++t)
+            queues.push_back(std::unique_ptr<task_queue>(new task_queue()));
+    }
+
+    size_t size() const {  return queues.size();  }
+
+    void submit(std::function<void()> f) {
+        queues[next_queue]->q.push_back(std::move(f));
+        next_queue=(next_queue+1) % queues.size();
+    }
+
+    void run() {
+        std::vector<std::thread> workers;
+        for(size_t t=1; t<queues.size(); ++t)
+            workers.push_back(std::thread(&task_pool::work, this, t));
+
+        work(0);
+
+        for(size_t t=0; t<workers.size(); ++t)
+            workers[t].join();
+    }
+};
+
+
+#endif
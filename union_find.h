@@ -0,0 +1,62 @@
+/* author: jakob fischer (mail@jakobfischer.eu)
+ * date: 16th October 2026
+ * description:
+ * Disjoint sets (union-find) over the elements 0..n-1 with union by size
+ * and path halving, used for the connected components of networks.
+ */
+
+#ifndef __JRNF_TOOLS_UNION_FIND_H__
+#define __JRNF_TOOLS_UNION_FIND_H__
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+
+class union_find {
+    std::vector<size_t> parent, size_;
+    size_t sets;
+
+public:
+    explicit union_find(size_t n=0) {  reset(n);  }
+
+    void reset(size_t n) {
+        parent.resize(n);
+        size_.assign(n, 1);
+        for(size_t i=0; i<n; ++i)
+            parent[i]=i;
+        sets=n;
+    }
+
+    size_t find(size_t x) {
+        while(parent[x] != x) {
+            parent[x]=parent[parent[x]];
+            x=parent[x];
+        }
+        return x;
+    }
+
+    // Joins the sets of `a` and `b`, returns false if they were joined already
+    bool unite(size_t a, size_t b) {
+        a=find(a);
+        b=find(b);
+        if(a == b)
+            return false;
+
+        if(size_[a] < size_[b])
+            std::swap(a, b);
+        parent[b]=a;
+        size_[a] += size_[b];
+        --sets;
+        return true;
+    }
+
+    bool connected(size_t a, size_t b) {  return find(a) == find(b);  }
+
+    size_t set_size(size_t x) {  return size_[find(x)];  }
+    size_t set_count() const {  return sets;  }
+    size_t size() const {  return parent.size();  }
+};
+
+
+#endif